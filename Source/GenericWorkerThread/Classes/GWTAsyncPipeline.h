@@ -0,0 +1,390 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include "GWTAsyncThreadPool.h"
+#include "GWTBoundedQueue.h"
+
+enum class EGWTPipelineFilterMode : uint8
+{
+    // Items are processed one at a time, in input order
+    Serial,
+
+    // Items are processed concurrently, in any order
+    Parallel
+};
+
+// Multi-stage streaming pipeline executed on a thread pool.
+//
+// Stages are declared once and items flow through them as tokens. The number
+// of tokens in flight is capped, item storage is preallocated per token and
+// recycled once a token leaves the last stage, keeping memory use bounded.
+// Serial stages reorder incoming tokens into a bounded slot buffer and are
+// drained by whichever thread acquires the stage, parallel stages dispatch
+// every token as separate thread pool work.
+//
+// The pipeline object must outlive the run, destruction waits for completion.
+// Completion is signalled by whichever thread releases the last reference of
+// the run, as its last access to the pipeline. References are held by the
+// open input, by every token in flight and by every queued pipeline work.
+// Pipeline work rejected or dropped by the thread pool runs inline.
+template<typename ItemType>
+class TGWTAsyncPipeline
+{
+public:
+
+    typedef TFunction<bool(ItemType&)> FInputFilter;
+    typedef TFunction<void(ItemType&)> FFilter;
+
+private:
+
+    struct FStage
+    {
+        EGWTPipelineFilterMode Mode;
+        FFilter Filter;
+
+        // Serial stage token slots, indexed by token sequence
+        TArray<int32> Slots;
+        int64 NextSequence = 0;
+        volatile int32 bActive = 0;
+    };
+
+    // Input pump work if the stage index is none, otherwise parallel stage work
+    struct FPipelineWork : public IQueuedWork
+    {
+        TGWTAsyncPipeline* Pipeline;
+        int32 StageIndex;
+        int32 Token;
+
+        FPipelineWork(TGWTAsyncPipeline* InPipeline, int32 InStageIndex, int32 InToken)
+            : Pipeline(InPipeline)
+            , StageIndex(InStageIndex)
+            , Token(InToken)
+        {
+        }
+
+        virtual void DoThreadedWork() override
+        {
+            TGWTAsyncPipeline* const WorkPipeline = Pipeline;
+            const int32 WorkStageIndex = StageIndex;
+            const int32 WorkToken = Token;
+
+            delete this;
+
+            WorkPipeline->ExecuteWork(WorkStageIndex, WorkToken);
+        }
+
+        // Dropped work is executed on the abandoning thread
+        virtual void Abandon() override
+        {
+            DoThreadedWork();
+        }
+    };
+
+    FGWTAsyncThreadPool& ThreadPool;
+    const int32 MaxTokens;
+
+    FInputFilter InputFilter;
+    TArray<TUniquePtr<FStage>> Stages;
+
+    TArray<ItemType> Items;
+    TArray<int64> TokenSequences;
+    TGWTBoundedQueue<int32> FreeTokens;
+
+    int64 NextInputSequence = 0;
+    volatile int32 bInputActive = 0;
+    volatile int32 bInputDone   = 0;
+    volatile int32 bRunning     = 0;
+    volatile int32 RefCount     = 0;
+
+    TPromise<void> CompletionPromise;
+    TFuture<void> CompletionFuture;
+
+public:
+
+    TGWTAsyncPipeline(FGWTAsyncThreadPool& InThreadPool, int32 InMaxTokens)
+        : ThreadPool(InThreadPool)
+        , MaxTokens(FMath::Max(InMaxTokens, 1))
+        , FreeTokens(FMath::Max(InMaxTokens, 1))
+    {
+        Items.SetNum(MaxTokens);
+        TokenSequences.SetNumZeroed(MaxTokens);
+
+        for (int32 i=0; i<MaxTokens; ++i)
+        {
+            FreeTokens.Enqueue(i);
+        }
+    }
+
+    ~TGWTAsyncPipeline()
+    {
+        Wait();
+    }
+
+    TGWTAsyncPipeline(const TGWTAsyncPipeline&) = delete;
+    TGWTAsyncPipeline& operator=(const TGWTAsyncPipeline&) = delete;
+
+    FORCEINLINE int32 GetMaxTokens() const
+    {
+        return MaxTokens;
+    }
+
+    FORCEINLINE int32 GetStageCount() const
+    {
+        return Stages.Num();
+    }
+
+    FORCEINLINE bool IsRunning() const
+    {
+        return FPlatformAtomics::AtomicRead(&bRunning) != 0;
+    }
+
+    // Input filter is always serial, returns false once the input is exhausted
+    void SetInputFilter(FInputFilter InInputFilter)
+    {
+        check(! IsRunning());
+        InputFilter = MoveTemp(InInputFilter);
+    }
+
+    void AddFilter(EGWTPipelineFilterMode Mode, FFilter Filter)
+    {
+        check(! IsRunning());
+        check(Filter);
+
+        TUniquePtr<FStage> Stage(new FStage);
+        Stage->Mode = Mode;
+        Stage->Filter = MoveTemp(Filter);
+
+        if (Mode == EGWTPipelineFilterMode::Serial)
+        {
+            Stage->Slots.Init(INDEX_NONE, MaxTokens);
+        }
+
+        Stages.Emplace(MoveTemp(Stage));
+    }
+
+    bool Run(TFunction<void()> CompletionCallback = TFunction<void()>())
+    {
+        if (! InputFilter || FPlatformAtomics::InterlockedCompareExchange(&bRunning, 1, 0) != 0)
+        {
+            return false;
+        }
+
+        for (TUniquePtr<FStage>& Stage : Stages)
+        {
+            Stage->NextSequence = 0;
+        }
+
+        NextInputSequence = 0;
+        bInputDone = 0;
+
+        CompletionPromise = TPromise<void>(MoveTemp(CompletionCallback));
+        CompletionFuture  = CompletionPromise.GetFuture();
+
+        // Open input reference, released once the input is exhausted
+        FPlatformAtomics::InterlockedExchange(&RefCount, 1);
+
+        QueueWork(INDEX_NONE, INDEX_NONE);
+
+        return true;
+    }
+
+    FORCEINLINE bool IsDone() const
+    {
+        return ! CompletionFuture.IsValid() || CompletionFuture.IsReady();
+    }
+
+    void Wait()
+    {
+        if (CompletionFuture.IsValid())
+        {
+            CompletionFuture.Wait();
+        }
+    }
+
+private:
+
+    void QueueWork(int32 StageIndex, int32 Token)
+    {
+        FPlatformAtomics::InterlockedIncrement(&RefCount);
+
+        FPipelineWork* Work = new FPipelineWork(this, StageIndex, Token);
+
+        // Rejected work is left untouched by the thread pool
+        if (! ThreadPool.AddQueuedWork(Work))
+        {
+            Work->DoThreadedWork();
+        }
+    }
+
+    void ExecuteWork(int32 StageIndex, int32 Token)
+    {
+        if (StageIndex == INDEX_NONE)
+        {
+            PumpInput();
+        }
+        else
+        {
+            Stages[StageIndex]->Filter(Items[Token]);
+            Dispatch(StageIndex+1, Token);
+        }
+
+        ReleaseRef();
+    }
+
+    // Pipeline must not be accessed once the last reference is released
+    void ReleaseRef()
+    {
+        if (FPlatformAtomics::InterlockedDecrement(&RefCount) != 0)
+        {
+            return;
+        }
+
+        TPromise<void> Promise(MoveTemp(CompletionPromise));
+        FPlatformAtomics::InterlockedExchange(&bRunning, 0);
+        Promise.SetValue();
+    }
+
+    void PumpInput()
+    {
+        for (;;)
+        {
+            if (FPlatformAtomics::InterlockedCompareExchange(&bInputActive, 1, 0) != 0)
+            {
+                return;
+            }
+
+            int32 Token;
+
+            while (! FPlatformAtomics::AtomicRead(&bInputDone) && FreeTokens.Dequeue(Token))
+            {
+                if (! InputFilter(Items[Token]))
+                {
+                    FreeTokens.Enqueue(Token);
+                    FPlatformAtomics::InterlockedExchange(&bInputDone, 1);
+
+                    // Caller executes within queued pipeline work, which
+                    // still holds a reference
+                    ReleaseRef();
+                    break;
+                }
+
+                TokenSequences[Token] = NextInputSequence++;
+                FPlatformAtomics::InterlockedIncrement(&RefCount);
+                Dispatch(0, Token);
+            }
+
+            FPlatformAtomics::InterlockedExchange(&bInputActive, 0);
+
+            if (FPlatformAtomics::AtomicRead(&bInputDone))
+            {
+                return;
+            }
+
+            // Re-check free tokens released while the input was still active
+            if (FreeTokens.IsEmpty())
+            {
+                return;
+            }
+        }
+    }
+
+    void Dispatch(int32 StageIndex, int32 Token)
+    {
+        if (StageIndex >= Stages.Num())
+        {
+            ReleaseToken(Token);
+            return;
+        }
+
+        FStage& Stage(*Stages[StageIndex]);
+
+        if (Stage.Mode == EGWTPipelineFilterMode::Serial)
+        {
+            const int32 SlotIndex = TokenSequences[Token] % MaxTokens;
+            FPlatformAtomics::InterlockedExchange(&Stage.Slots[SlotIndex], Token);
+            DrainSerial(StageIndex);
+        }
+        else
+        {
+            QueueWork(StageIndex, Token);
+        }
+    }
+
+    void DrainSerial(int32 StageIndex)
+    {
+        FStage& Stage(*Stages[StageIndex]);
+
+        for (;;)
+        {
+            if (FPlatformAtomics::InterlockedCompareExchange(&Stage.bActive, 1, 0) != 0)
+            {
+                return;
+            }
+
+            for (;;)
+            {
+                const int32 SlotIndex = Stage.NextSequence % MaxTokens;
+                const int32 Token = FPlatformAtomics::InterlockedExchange(&Stage.Slots[SlotIndex], INDEX_NONE);
+
+                if (Token == INDEX_NONE)
+                {
+                    break;
+                }
+
+                ++Stage.NextSequence;
+                Stage.Filter(Items[Token]);
+                Dispatch(StageIndex+1, Token);
+            }
+
+            const int32 NextSlotIndex = Stage.NextSequence % MaxTokens;
+
+            FPlatformAtomics::InterlockedExchange(&Stage.bActive, 0);
+
+            // Re-check the next slot for token pushed before the stage was released
+            if (FPlatformAtomics::AtomicRead(&Stage.Slots[NextSlotIndex]) == INDEX_NONE)
+            {
+                return;
+            }
+        }
+    }
+
+    void ReleaseToken(int32 Token)
+    {
+        FreeTokens.Enqueue(Token);
+
+        if (! FPlatformAtomics::AtomicRead(&bInputDone))
+        {
+            PumpInput();
+        }
+
+        ReleaseRef();
+    }
+};
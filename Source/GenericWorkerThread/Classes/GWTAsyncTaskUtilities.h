@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/LatentActionManager.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "GWTAsyncThreadPool.h"
+#include "GWTAsyncTaskUtilities.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FGWTAsyncTaskAction_OnTaskCompleted);
+
+UCLASS()
+class GENERICWORKERTHREAD_API UGWTAsyncTaskUtilityLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+
+    // Enqueues task to the named thread pool and resumes execution on the
+    // game thread tick once the task is either done or cancelled.
+    // Uses the task thread pool if pool name is none.
+    UFUNCTION(BlueprintCallable, meta=(Latent, LatentInfo="LatentInfo", WorldContext="WorldContextObject", AdvancedDisplay="ThreadCount"))
+    static void ExecuteTaskLatent(
+        UObject* WorldContextObject,
+        FLatentActionInfo LatentInfo,
+        UPARAM(ref) FGWTAsyncTaskRef& TaskRef,
+        FName PoolName,
+        EGWTAsyncTaskState& OutTaskState,
+        int32 ThreadCount = 1
+        );
+};
+
+UCLASS()
+class GENERICWORKERTHREAD_API UGWTAsyncTaskAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintAssignable)
+    FGWTAsyncTaskAction_OnTaskCompleted OnTaskDone;
+
+	UPROPERTY(BlueprintAssignable)
+    FGWTAsyncTaskAction_OnTaskCompleted OnTaskCancelled;
+
+	UPROPERTY(BlueprintAssignable)
+    FGWTAsyncTaskAction_OnTaskCompleted OnTaskFailed;
+
+    // Enqueues task to the named thread pool, completion pins are executed
+    // on the next game thread tick once the task is either done or cancelled.
+    // Uses the task thread pool if pool name is none.
+    UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", DisplayName="Execute Async Task", AdvancedDisplay="ThreadCount"))
+    static UGWTAsyncTaskAction* ExecuteAsyncTask(
+        UObject* WorldContextObject,
+        const FGWTAsyncTaskRef& TaskRef,
+        FName PoolName,
+        int32 ThreadCount = 1
+        );
+
+    // -- BEGIN UBlueprintAsyncActionBase
+
+    virtual void Activate() override;
+
+    // -- END UBlueprintAsyncActionBase
+
+private:
+
+    FGWTAsyncTaskRef TaskRef;
+    FName PoolName;
+    int32 ThreadCount;
+
+    void BroadcastTaskState(EGWTAsyncTaskState TaskState);
+};
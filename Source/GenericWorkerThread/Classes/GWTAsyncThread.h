@@ -28,25 +28,130 @@
 #pragma once
 
 #include "Async/Async.h"
+#include "HAL/Event.h"
 #include "HAL/PlatformProcess.h"
 #include "HAL/ThreadSafeBool.h"
+#include "Misc/ScopeLock.h"
 #include "Containers/Queue.h"
 #include "Containers/List.h"
+#include "GenericWorkerThread.h"
+#include "GWTAsyncThreadPool.h"
+#include "GWTCacheLine.h"
+#include "GWTExecutor.h"
+#include "GWTIdlePolicy.h"
 #include "GWTTaskWorker.h"
+#include "GWTTypedWorkerList.h"
+
+#include <cmath>
 
 typedef TSharedPtr<class FGWTAsyncThread> FPSGWTAsyncThread;
 typedef TWeakPtr<class FGWTAsyncThread>   FPWGWTAsyncThread;
 
-class FGWTAsyncThread
+// Completion latch of worker commands, owned by the caller and released
+// by the thread once the commands have been processed. A single latch may
+// track multiple commands, it must outlive all of its pending commands.
+class FGWTWorkerLatch
+{
+    friend class FGWTAsyncThread;
+
+    volatile int32 PendingCount;
+
+    FORCEINLINE void AddPending()
+    {
+        FPlatformAtomics::InterlockedIncrement(&PendingCount);
+    }
+
+    FORCEINLINE void Release()
+    {
+        FPlatformAtomics::InterlockedDecrement(&PendingCount);
+    }
+
+public:
+
+    FGWTWorkerLatch()
+        : PendingCount(0)
+    {
+    }
+
+    ~FGWTWorkerLatch()
+    {
+        check(IsDone());
+    }
+
+    FGWTWorkerLatch(const FGWTWorkerLatch&) = delete;
+    FGWTWorkerLatch& operator=(const FGWTWorkerLatch&) = delete;
+
+    FORCEINLINE bool IsDone() const
+    {
+        return FPlatformAtomics::AtomicRead(&PendingCount) == 0;
+    }
+
+    // Spins and yields briefly, then sleeps with exponential backoff of up
+    // to a millisecond. The latch is not signalled through an event as the
+    // waiter may destroy the latch as soon as the last command is released.
+    void Wait() const
+    {
+        if (FGWTIdlePolicy().SpinYield([this]() { return IsDone(); }))
+        {
+            return;
+        }
+
+        float SleepTime = 0.00005f;
+
+        while (! IsDone())
+        {
+            FPlatformProcess::SleepNoStats(SleepTime);
+            SleepTime = FMath::Min(SleepTime * 2.f, 0.001f);
+        }
+    }
+};
+
+enum class EGWTOverrunAction : uint8
+{
+    // Only count and log overruns
+    None,
+
+    // Double worker tick interval up to the max tick interval
+    Demote,
+
+    // Move worker to its own thread through the isolate worker callback,
+    // demotes worker if there is no isolate worker callback
+    Isolate
+};
+
+struct FGWTOverrunPolicy
+{
+    EGWTOverrunAction Action = EGWTOverrunAction::Demote;
+
+    // Consecutive overruns before the worker is considered a chronic offender
+    int32 ChronicOverrunCount = 8;
+
+    int32 MaxTickInterval = 8;
+};
+
+class FGWTAsyncThread : public IGWTExecutor
 {
 
 public:
 
     typedef TFunction<void()> FAsyncCallback;
 
+    // Executed on the thread with the isolated worker, which remains owned
+    // and ticked by the thread until it is migrated through MigrateWorker
+    typedef TFunction<void(FGWTAsyncThread&, const FPSGWTTaskWorker&)> FIsolateWorkerCallback;
+
 	FGWTAsyncThread(float InRestTime)
-        : bIsThreadStopped(false)
-        , RestTime(InRestTime)
+        : RestTime(InRestTime)
+        , WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+        , ThreadId(0)
+        , bIsThreadStopped(false)
+        , bIsThreadHalted(false)
+        , bWakeRequested(false)
+        , TickStartCycles(0)
+        , TickingWorkerId(-1)
+        , AverageLoopTimeUsec(0)
+        , WorkerCount(0)
+        , bTickScheduleDirty(true)
     {
     }
 
@@ -54,10 +159,11 @@ public:
     {
         StopThread();
 
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+
         WorkerList.Empty();
-        WorkerEntries.Empty();
-        WorkerRemovals.Empty();
-        WorkerRemovalPromises.Empty();
+        WorkerCommands.Empty();
 	}
 
     void StartThread()
@@ -72,6 +178,11 @@ public:
             return;
         }
 
+        {
+            FScopeLock HaltedScopeLock(&HaltedCommandLock);
+            bIsThreadHalted = false;
+        }
+
         bIsThreadStopped = false;
 
         FAsyncCallback AsyncExec( [&, this]() {
@@ -96,20 +207,42 @@ public:
 
         bIsThreadStopped = true;
 
+        Wake();
+
         ThreadFuture.Get();
         ThreadFuture = TFuture<void>();
+        FPlatformAtomics::InterlockedExchange(&ThreadId, 0);
+
+        // Commands enqueued from now on are resolved on the enqueuing thread
+        FScopeLock HaltedScopeLock(&HaltedCommandLock);
+        bIsThreadHalted = true;
 
-        // Process pending worker entries
-        ProcessWorkerEntries();
+        // Process pending worker commands
+        ProcessWorkerCommands();
 
         // Registers remaining workers for removal
+        TArray<FPWGWTTaskWorker> RemainingWorkers;
+        RemainingWorkers.Reserve(WorkerList.Num());
+
         for (FPWGWTTaskWorker& t : WorkerList)
         {
-            RemoveWorkerAsync(t);
+            RemainingWorkers.Emplace(t);
         }
 
+        RemoveWorkers(RemainingWorkers);
+
         // Finally, proceed to remove all workers
-        ProcessWorkerEntries();
+        ProcessWorkerCommands();
+
+        // Remaining posted callbacks are executed on the stopping thread
+        ExecutePostedCallbacks();
+
+        for (const FPSGWTTypedWorkerList& TypedList : TypedWorkerLists)
+        {
+            TypedList->ShutdownWorkers();
+        }
+
+        TypedWorkerLists.Empty();
     }
 
 	void SetRestTime(float InRestTime)
@@ -122,6 +255,25 @@ public:
         return RestTime;
 	}
 
+    // Idle policy used while the thread rests between loops
+    // or while waiting for workers to be added
+	void SetIdlePolicy(const FGWTIdlePolicy& InIdlePolicy)
+	{
+        IdlePolicy = InIdlePolicy;
+	}
+
+	FORCEINLINE const FGWTIdlePolicy& GetIdlePolicy() const
+	{
+        return IdlePolicy;
+	}
+
+    // Ends the current rest period and starts the next thread loop
+    FORCEINLINE void Wake()
+    {
+        bWakeRequested = true;
+        WakeEvent->Trigger();
+    }
+
 	FORCEINLINE bool IsThreadStarted() const
 	{
 		return ThreadFuture.IsValid();
@@ -134,129 +286,1218 @@ public:
 
 	// === END Thread Control
 
-	void AddWorker(FPWGWTTaskWorker w)
+    // -- BEGIN IGWTExecutor
+
+    // Posted callbacks are executed at the start of the next thread loop,
+    // before workers are ticked. Deferred callbacks submitted from the
+    // thread itself do not trigger the wake event.
+
+    virtual bool Post(FExecutorCallback Callback) override
+    {
+        PostedCallbacks.Enqueue(MoveTemp(Callback));
+        PostedCallbackCount.Increment();
+        Wake();
+        return true;
+    }
+
+    virtual bool Defer(FExecutorCallback Callback) override
+    {
+        if (! IsInExecutorContext())
+        {
+            return Post(MoveTemp(Callback));
+        }
+
+        PostedCallbacks.Enqueue(MoveTemp(Callback));
+        PostedCallbackCount.Increment();
+        bWakeRequested = true;
+        return true;
+    }
+
+    virtual bool BulkPost(TArray<FExecutorCallback>&& Callbacks) override
+    {
+        for (FExecutorCallback& Callback : Callbacks)
+        {
+            PostedCallbacks.Enqueue(MoveTemp(Callback));
+        }
+
+        PostedCallbackCount.Add(Callbacks.Num());
+        Callbacks.Reset();
+        Wake();
+        return true;
+    }
+
+    virtual bool IsInExecutorContext() const override
+    {
+        const uint32 CurrentThreadId = static_cast<uint32>(FPlatformAtomics::AtomicRead(&ThreadId));
+        return CurrentThreadId != 0 && FPlatformTLS::GetCurrentThreadId() == CurrentThreadId;
+    }
+
+    // -- END IGWTExecutor
+
+    // Assigns thread pool used to tick independent workers concurrently.
+    // Workers within the same tick level are dispatched to the pool while
+    // the owning thread waits for the level to complete before proceeding.
+    void SetTickThreadPool(const FPSGWTAsyncThreadPool& InTickThreadPool)
+    {
+        check(! IsThreadStarted());
+        TickThreadPool = InTickThreadPool;
+    }
+
+    FORCEINLINE FPSGWTAsyncThreadPool GetTickThreadPool() const
+    {
+        return TickThreadPool;
+    }
+
+    // Rebuild tick schedule on the next loop, required after worker
+    // tick group or tick prerequisites are modified after registration
+    FORCEINLINE void InvalidateTickSchedule()
+    {
+        bTickScheduleDirty = true;
+    }
+
+    // Worker Registration
+    //
+    // Worker add and remove commands are processed in submission order at
+    // the start of the next thread loop. Commands may optionally release
+    // a caller owned latch once processed. A worker may only be registered
+    // on a single thread at a time.
+
+	void AddWorker(FPWGWTTaskWorker w, FGWTWorkerLatch* Latch = nullptr)
+	{
+        FWorkerCommand Command(EWorkerCommand::Add, Latch);
+        Command.Workers.Emplace(MoveTemp(w));
+        EnqueueWorkerCommand(MoveTemp(Command));
+	}
+
+	void AddWorkers(const TArray<FPWGWTTaskWorker>& Workers, FGWTWorkerLatch* Latch = nullptr)
 	{
-        WorkerEntries.Enqueue(w);
+        FWorkerCommand Command(EWorkerCommand::Add, Latch);
+        Command.Workers.Append(Workers);
+        EnqueueWorkerCommand(MoveTemp(Command));
 	}
 
+	FORCEINLINE void RemoveWorker(FPWGWTTaskWorker Worker, FGWTWorkerLatch& Latch)
+	{
+        FWorkerCommand Command(EWorkerCommand::Remove, &Latch);
+        Command.Workers.Emplace(MoveTemp(Worker));
+        EnqueueWorkerCommand(MoveTemp(Command));
+	}
+
+    // Returned future resolves once the worker has been removed,
+    // prefer the latch overload which does not allocate a promise
 	FORCEINLINE TFuture<void> RemoveWorker(FPWGWTTaskWorker Worker)
 	{
-        WorkerRemovals.Enqueue(Worker);
-        FPSRemovalPromise RemovalPromise( MakeShareable(new TPromise<void>()) );
-        WorkerRemovalPromises.Enqueue(RemovalPromise);
-        return RemovalPromise->GetFuture();
+        FWorkerCommand Command(EWorkerCommand::Remove, nullptr);
+        Command.Workers.Emplace(MoveTemp(Worker));
+        Command.RemovalPromise = MakeShareable(new TPromise<void>());
+        TFuture<void> RemovalFuture(Command.RemovalPromise->GetFuture());
+        EnqueueWorkerCommand(MoveTemp(Command));
+        return RemovalFuture;
 	}
 
 	FORCEINLINE void RemoveWorkerAsync(FPWGWTTaskWorker Worker)
 	{
-        WorkerRemovals.Enqueue(Worker);
+        FWorkerCommand Command(EWorkerCommand::Remove, nullptr);
+        Command.Workers.Emplace(MoveTemp(Worker));
+        EnqueueWorkerCommand(MoveTemp(Command));
+	}
+
+	void RemoveWorkers(const TArray<FPWGWTTaskWorker>& Workers, FGWTWorkerLatch* Latch = nullptr)
+	{
+        FWorkerCommand Command(EWorkerCommand::Remove, Latch);
+        Command.Workers.Append(Workers);
+        EnqueueWorkerCommand(MoveTemp(Command));
+	}
+
+    // Worker Migration
+    //
+    // Migrated workers are moved between ticks without being shut down and
+    // set up again, keeping their tick time state. Only workers without
+    // tick prerequisites and dependents are migrated.
+
+    // Moving average of the time spent ticking workers each thread loop
+    FORCEINLINE double GetAverageLoopTime() const
+    {
+        return FPlatformAtomics::AtomicRead(&AverageLoopTimeUsec) * 1e-6;
+    }
+
+    // Migrates workers with combined average tick cost of up to the
+    // specified cost to the target thread, most expensive workers first
+	void MigrateWorkers(double MaxTickCost, const FPSGWTAsyncThread& TargetThread)
+	{
+        check(TargetThread.IsValid());
+        FWorkerCommand Command(EWorkerCommand::MigrateOut, nullptr);
+        Command.MigrationCost = MaxTickCost;
+        Command.TargetThread = TargetThread;
+        EnqueueWorkerCommand(MoveTemp(Command));
+	}
+
+    // Migrates worker if it is still owned by the thread, the latch is
+    // released once the target thread has adopted the worker
+	void MigrateWorker(FPWGWTTaskWorker Worker, const FPSGWTAsyncThread& TargetThread, FGWTWorkerLatch* Latch = nullptr)
+	{
+        check(TargetThread.IsValid());
+        FWorkerCommand Command(EWorkerCommand::MigrateOut, Latch);
+        Command.Workers.Emplace(MoveTemp(Worker));
+        Command.TargetThread = TargetThread;
+        EnqueueWorkerCommand(MoveTemp(Command));
+	}
+
+    // Excluded threads are neither source nor target of load balancing
+    FORCEINLINE void SetExcludeFromBalancing(bool bInExcludeFromBalancing)
+    {
+        bExcludeFromBalancing = bInExcludeFromBalancing;
+    }
+
+    FORCEINLINE bool IsExcludedFromBalancing() const
+    {
+        return bExcludeFromBalancing;
+    }
+
+    // Registers worker detached from another thread without setting it up
+	void AdoptWorker(FPWGWTTaskWorker Worker, FGWTWorkerLatch* Latch = nullptr)
+	{
+        FWorkerCommand Command(EWorkerCommand::Adopt, Latch);
+        Command.Workers.Emplace(MoveTemp(Worker));
+        EnqueueWorkerCommand(MoveTemp(Command));
+	}
+
+    FORCEINLINE int32 GetWorkerCount() const
+    {
+        return FPlatformAtomics::AtomicRead(&WorkerCount);
+    }
+
+    // Typed Worker Lists
+    //
+    // Typed worker lists tick after all polymorphic workers each thread loop,
+    // in the order they have been added. Remaining workers of hosted lists
+    // are destroyed when the thread stops.
+
+	void AddTypedWorkerList(const FPSGWTTypedWorkerList& TypedList, FGWTWorkerLatch* Latch = nullptr)
+	{
+        check(TypedList.IsValid());
+        FWorkerCommand Command(EWorkerCommand::AddTypedList, Latch);
+        Command.TypedList = TypedList;
+        EnqueueWorkerCommand(MoveTemp(Command));
+	}
+
+    // Removed list keeps its workers, shut down workers explicitly if required
+	void RemoveTypedWorkerList(const FPSGWTTypedWorkerList& TypedList, FGWTWorkerLatch* Latch = nullptr)
+	{
+        check(TypedList.IsValid());
+        FWorkerCommand Command(EWorkerCommand::RemoveTypedList, Latch);
+        Command.TypedList = TypedList;
+        EnqueueWorkerCommand(MoveTemp(Command));
+	}
+
+    // Tick Budget Enforcement
+
+	void SetOverrunPolicy(const FGWTOverrunPolicy& InOverrunPolicy)
+	{
+        check(! IsThreadStarted());
+        OverrunPolicy = InOverrunPolicy;
+	}
+
+	FORCEINLINE const FGWTOverrunPolicy& GetOverrunPolicy() const
+	{
+        return OverrunPolicy;
+	}
+
+	void SetIsolateWorkerCallback(FIsolateWorkerCallback InIsolateWorkerCallback)
+	{
+        check(! IsThreadStarted());
+        IsolateWorkerCallback = MoveTemp(InIsolateWorkerCallback);
 	}
 
+    // Time spent in the current thread loop, from command processing up to
+    // the end of worker ticks, zero while resting
+    double GetCurrentTickTime() const
+    {
+        const int64 StartCycles = FPlatformAtomics::AtomicRead(&TickStartCycles);
+        return StartCycles > 0
+            ? FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles)
+            : 0.0;
+    }
+
+    // Id of the worker that most recently started ticking
+    FORCEINLINE int32 GetTickingWorkerId() const
+    {
+        return FPlatformAtomics::AtomicRead(&TickingWorkerId);
+    }
+
 private:
 
     typedef TDoubleLinkedList<FPWGWTTaskWorker>       FGWTTaskWorkerList;
     typedef FGWTTaskWorkerList::TDoubleLinkedListNode FGWTTaskWorkerListNode;
     typedef TSharedPtr<TPromise<void>> FPSRemovalPromise;
 
+    enum class EWorkerCommand : uint8
+    {
+        Add,
+        Remove,
+        MigrateOut,
+        Adopt,
+        AddTypedList,
+        RemoveTypedList
+    };
+
+    struct FWorkerCommand
+    {
+        EWorkerCommand Type;
+        TArray<FPWGWTTaskWorker, TInlineAllocator<1>> Workers;
+        FGWTWorkerLatch* Latch;
+        FPSRemovalPromise RemovalPromise;
+        FPSGWTTypedWorkerList TypedList;
+
+        // Migration parameters, specified workers are migrated regardless of cost
+        double MigrationCost;
+        FPWGWTAsyncThread TargetThread;
+
+        FWorkerCommand()
+            : Type(EWorkerCommand::Add)
+            , Latch(nullptr)
+            , MigrationCost(0.0)
+        {
+        }
+
+        FWorkerCommand(EWorkerCommand InType, FGWTWorkerLatch* InLatch)
+            : Type(InType)
+            , Latch(InLatch)
+            , MigrationCost(0.0)
+        {
+        }
+    };
+
+    // Configuration, written before the thread starts or rarely changed
+
     TFuture<void> ThreadFuture;
-	FThreadSafeBool bIsThreadStopped;
 	float RestTime;
+    FEvent* WakeEvent;
+    FGWTIdlePolicy IdlePolicy;
+
+    // Written by the thread on start and by the stopping thread, read from any thread
+    volatile int32 ThreadId;
+
+    FGWTOverrunPolicy OverrunPolicy;
+    FIsolateWorkerCallback IsolateWorkerCallback;
+    FThreadSafeBool bExcludeFromBalancing;
+
+    // Serializes command processing on enqueuing threads once the thread
+    // has exited, set halted while the thread is not running after a stop
+    FCriticalSection HaltedCommandLock;
+
+    // Control state written by other threads, polled by the thread each loop
 
+    GWT_CACHE_PAD;
+	FThreadSafeBool bIsThreadStopped;
+    FThreadSafeBool bIsThreadHalted;
+    FThreadSafeBool bWakeRequested;
+    FThreadSafeCounter PostedCallbackCount;
+
+    // Loop state written by the thread each loop,
+    // read by the watchdog and the load balancer
+
+    GWT_CACHE_PAD;
+    volatile int64 TickStartCycles;
+    volatile int32 TickingWorkerId;
+    volatile int32 AverageLoopTimeUsec;
+    volatile int32 WorkerCount;
+
+    // Queues written by other threads, each queue head is consumed by the thread
+
+    GWT_CACHE_PAD;
+    TQueue<FWorkerCommand, EQueueMode::Mpsc> WorkerCommands;
+    TQueue<FExecutorCallback, EQueueMode::Mpsc> PostedCallbacks;
+    TQueue<FPWGWTTaskWorker, EQueueMode::Mpsc> PendingIsolations;
+
+    // Worker registration, only accessed by the thread
+
+    GWT_CACHE_PAD;
     FGWTTaskWorkerList WorkerList;
-	TQueue<FPWGWTTaskWorker, EQueueMode::Mpsc> WorkerEntries;
-	TQueue<FPWGWTTaskWorker, EQueueMode::Mpsc> WorkerRemovals;
-    TQueue<FPSRemovalPromise, EQueueMode::Mpsc> WorkerRemovalPromises;
+    TArray<FPSGWTTypedWorkerList> TypedWorkerLists;
 
     int32 _UniqueWorkerId = 0;
 
+    // Worker tick schedule, workers are sorted by tick group and tick level.
+    // Tick level [i] spans TickOrder[TickLevelOffsets[i], TickLevelOffsets[i+1]).
+    TArray<FPWGWTTaskWorker> TickOrder;
+    TArray<int32> TickLevelOffsets;
+    FThreadSafeBool bTickScheduleDirty;
+    FPSGWTAsyncThreadPool TickThreadPool;
+
 	void Run()
     {
-        double LastUpdateTime = FPlatformTime::Seconds();
-
-        // Initial sleep
-        FPlatformProcess::Sleep(0.03);
+        FPlatformAtomics::InterlockedExchange(&ThreadId, static_cast<int32>(FPlatformTLS::GetCurrentThreadId()));
 
         while (! IsThreadStopped())
         {
-            ProcessWorkerEntries();
+            // Watchdog covers command processing and posted callbacks as well
+            FPlatformAtomics::InterlockedExchange(&TickStartCycles, static_cast<int64>(FPlatformTime::Cycles64()));
+
+            ProcessWorkerCommands();
+            ExecutePostedCallbacks();
 
-            if (WorkerList.Num() > 0)
+            if (bTickScheduleDirty)
             {
-                FGWTTaskWorkerListNode* Node0( nullptr );
-                FGWTTaskWorkerListNode* Node1( WorkerList.GetHead() );
-                do
-                {
-                    Node0 = Node1;
-                    Node1 = Node0->GetNextNode();
+                BuildTickSchedule();
+            }
 
-                    FPSGWTTaskWorker Worker( Node0->GetValue().Pin() );
+            const double LoopStartTime = FPlatformTime::Seconds();
 
-                    if (Worker.IsValid())
-                    {
-                        double DeltaTime = FPlatformTime::Seconds() - LastUpdateTime;
-                        Worker->Tick(DeltaTime);
-                    }
-                    else
+            for (int32 Level=0; Level<(TickLevelOffsets.Num()-1); ++Level)
+            {
+                const int32 LevelBegin = TickLevelOffsets[Level];
+                const int32 LevelEnd   = TickLevelOffsets[Level+1];
+
+                if (TickThreadPool.IsValid() && (LevelEnd-LevelBegin) > 1)
+                {
+                    TickLevelParallel(LevelBegin, LevelEnd);
+                }
+                else
+                {
+                    for (int32 i=LevelBegin; i<LevelEnd; ++i)
                     {
-                        WorkerList.RemoveNode(Node0);
+                        TickWorker(i);
                     }
                 }
-                while (Node1);
             }
 
-            LastUpdateTime = FPlatformTime::Seconds();
-
-            if (RestTime > 0.f)
+            if (TypedWorkerLists.Num() > 0)
             {
-                FPlatformProcess::Sleep(RestTime);
+                TickTypedWorkerLists();
             }
+
+            FPlatformAtomics::InterlockedExchange(&TickStartCycles, 0);
+            UpdateAverageLoopTime(FPlatformTime::Seconds() - LoopStartTime);
+
+            ProcessPendingIsolations();
+
+            Rest();
         }
 	}
 
-    void ProcessWorkerEntries()
+    void ExecutePostedCallbacks()
     {
-        if (WorkerEntries.IsEmpty() && WorkerRemovals.IsEmpty())
-        {
-            return;
-        }
+        // Only execute callbacks posted before this call,
+        // callbacks posted during execution run on the next loop
+
+        const int32 CallbackCount = PostedCallbackCount.GetValue();
 
-        while (! WorkerEntries.IsEmpty())
+        for (int32 i=0; i<CallbackCount; ++i)
         {
-            FPWGWTTaskWorker pWorker;
-            WorkerEntries.Dequeue(pWorker);
+            FExecutorCallback Callback;
 
-            if (pWorker.IsValid() && ! WorkerList.Contains(pWorker))
+            // Counted callback may not yet be visible in the queue
+            while (! PostedCallbacks.Dequeue(Callback))
             {
-                FPSGWTTaskWorker Worker( pWorker.Pin() );
-                WorkerList.AddTail(Worker);
-                Worker->_TaskWorkerId = _UniqueWorkerId++;
-                Worker->SetupTaskWorker();
+                FPlatformProcess::Yield();
             }
+
+            if (Callback)
+            {
+                GWT_TRACE_SCOPE("GWT.Thread.PostedCallback");
+                Callback();
+            }
+        }
+
+        PostedCallbackCount.Subtract(CallbackCount);
+    }
+
+    void TickTypedWorkerLists()
+    {
+        FPlatformAtomics::InterlockedExchange(&TickingWorkerId, -1);
+
+        const double CurrentTime = FPlatformTime::Seconds();
+
+        for (const FPSGWTTypedWorkerList& TypedList : TypedWorkerLists)
+        {
+            TypedList->TickWorkers(CurrentTime);
         }
+    }
 
-        while (! WorkerRemovals.IsEmpty())
+    void Rest()
+    {
+        const bool bHasWorkers = TickOrder.Num() > 0 || TypedWorkerLists.Num() > 0;
+
+        // Busy loop while there are workers to tick without rest time
+        if (bHasWorkers && RestTime <= 0.f)
         {
-            FPWGWTTaskWorker pWorker;
-            WorkerRemovals.Dequeue(pWorker);
+            bWakeRequested = false;
+            return;
+        }
+
+        // Rest until the rest time ends, without any worker the thread
+        // rests until it is explicitly woken
+
+        const double EndTime = bHasWorkers
+            ? FPlatformTime::Seconds() + RestTime
+            : -1.0;
+
+        const FGWTIdlePolicy ThreadIdlePolicy(IdlePolicy);
+
+        const bool bWoken = ThreadIdlePolicy.SpinYield(
+            [this]()
+            {
+                return bWakeRequested || IsThreadStopped() || PostedCallbackCount.GetValue() > 0;
+            },
+            EndTime );
 
-            if (WorkerList.Contains(pWorker))
+        if (! bWoken && ThreadIdlePolicy.bPark)
+        {
+            if (EndTime < 0.0)
+            {
+                WakeEvent->Wait();
+            }
+            else
             {
-                WorkerList.RemoveNode(pWorker);
+                const double RemainingTime = EndTime - FPlatformTime::Seconds();
 
-                if (pWorker.IsValid())
+                if (RemainingTime > 0.0)
                 {
-                    FPSGWTTaskWorker Worker( pWorker.Pin() );
-                    Worker->ShutdownTaskWorker();
-                    Worker->_TaskWorkerId = -1;
+                    WakeEvent->Wait(FMath::CeilToInt(RemainingTime * 1000.0));
                 }
             }
         }
 
-        while (! WorkerRemovalPromises.IsEmpty())
+        bWakeRequested = false;
+    }
+
+    void TickWorker(int32 WorkerIndex)
+    {
+        FPSGWTTaskWorker Worker( TickOrder[WorkerIndex].Pin() );
+
+        if (Worker.IsValid())
+        {
+            // Demoted worker, skip loops until the tick interval elapses
+            if (Worker->TickInterval > 1 && (++Worker->_TickIntervalCounter % Worker->TickInterval) != 0)
+            {
+                return;
+            }
+
+            FPlatformAtomics::InterlockedExchange(&TickingWorkerId, Worker->_TaskWorkerId);
+
+            // Delta time is measured from the worker own last tick
+            GWT_TRACE_SCOPE("GWT.Worker.Tick");
+
+            const double CurrentTime = FPlatformTime::Seconds();
+            const double DeltaTime = CurrentTime - Worker->_LastTickTime;
+            Worker->_LastTickTime = CurrentTime;
+
+            if (Worker->IsFixedTimeStep())
+            {
+                TickWorkerFixed(*Worker, DeltaTime);
+            }
+            else
+            {
+                Worker->Tick(DeltaTime);
+            }
+
+            // Exponential moving average of tick cost, alpha 1/8
+            const double TickCost = FPlatformTime::Seconds() - CurrentTime;
+            Worker->_AverageTickCost += (TickCost - Worker->_AverageTickCost) * 0.125;
+
+            if (Worker->TickBudget > 0.f)
+            {
+                CheckTickBudget(Worker, TickCost);
+            }
+        }
+        else
+        {
+            // Expired worker, remove on the next schedule build
+            bTickScheduleDirty = true;
+        }
+    }
+
+    void TickWorkerFixed(IGWTTaskWorker& Worker, double DeltaTime)
+    {
+        const float TimeStep = Worker.FixedTimeStep;
+        const int32 MaxSubsteps = Worker.MaxSubsteps;
+
+        double& Accumulator(Worker._TickTimeAccumulator);
+        Accumulator += DeltaTime;
+
+        int32 Substeps = 0;
+
+        while (Accumulator >= TimeStep && Substeps < MaxSubsteps)
+        {
+            Worker.Tick(TimeStep);
+            Accumulator -= TimeStep;
+            ++Substeps;
+        }
+
+        // Substep cap reached, discard remaining whole steps,
+        // FMath::Fmod would narrow the accumulator to float
+        if (Accumulator >= TimeStep)
         {
-            FPSRemovalPromise RemovalPromise;
-            WorkerRemovalPromises.Dequeue(RemovalPromise);
-            RemovalPromise->SetValue();
+            Accumulator = std::fmod(Accumulator, static_cast<double>(TimeStep));
+        }
+    }
+
+    void TickLevelParallel(int32 LevelBegin, int32 LevelEnd)
+    {
+        const int32 QueuedCount = LevelEnd-LevelBegin-1;
+
+        TArray<TFuture<void>> TickFutures;
+        TickFutures.Reserve(QueuedCount);
+
+        // Rejected or dropped work resolves its future without being executed
+        TArray<int32> TickedFlags;
+        TickedFlags.SetNumZeroed(QueuedCount);
+        int32* TickedFlagData = TickedFlags.GetData();
+
+        for (int32 i=LevelBegin+1; i<LevelEnd; ++i)
+        {
+            int32* TickedFlag = TickedFlagData + (i-LevelBegin-1);
+
+            TickFutures.Emplace(TickThreadPool->AddQueuedWork(
+                [this, i, TickedFlag]()
+                {
+                    TickWorker(i);
+                    FPlatformAtomics::InterlockedExchange(TickedFlag, 1);
+                } ) );
+        }
+
+        // Tick first worker on the owning thread
+        TickWorker(LevelBegin);
+
+        for (int32 i=0; i<QueuedCount; ++i)
+        {
+            if (TickFutures[i].IsValid())
+            {
+                TickFutures[i].Wait();
+            }
+
+            // Tick workers whose work has not been executed on the owning thread
+            if (FPlatformAtomics::AtomicRead(&TickedFlagData[i]) == 0)
+            {
+                TickWorker(LevelBegin+1+i);
+            }
+        }
+    }
+
+    void BuildTickSchedule()
+    {
+        bTickScheduleDirty = false;
+
+        TickOrder.Reset();
+        TickLevelOffsets.Reset();
+
+        // Gather valid workers and remove expired list entries
+
+        TArray<FPSGWTTaskWorker> Workers;
+        Workers.Reserve(WorkerList.Num());
+
+        FGWTTaskWorkerListNode* Node( WorkerList.GetHead() );
+
+        while (Node)
+        {
+            FGWTTaskWorkerListNode* NextNode( Node->GetNextNode() );
+            FPSGWTTaskWorker Worker( Node->GetValue().Pin() );
+
+            if (Worker.IsValid())
+            {
+                Workers.Emplace(MoveTemp(Worker));
+            }
+            else
+            {
+                WorkerList.RemoveNode(Node);
+                FPlatformAtomics::InterlockedDecrement(&WorkerCount);
+            }
+
+            Node = NextNode;
+        }
+
+        // Resolve tick level of each worker from its prerequisites
+
+        TMap<const IGWTTaskWorker*, int32> TickLevelMap;
+        TickLevelMap.Reserve(Workers.Num());
+
+        for (const FPSGWTTaskWorker& Worker : Workers)
+        {
+            TickLevelMap.Emplace(Worker.Get(), INDEX_NONE);
+            Worker->_bHasTickDependents = false;
+        }
+
+        TArray<TPair<FPSGWTTaskWorker, int32>> WorkerLevels;
+        WorkerLevels.Reserve(Workers.Num());
+
+        for (const FPSGWTTaskWorker& Worker : Workers)
+        {
+            WorkerLevels.Emplace(Worker, ResolveTickLevel(*Worker, TickLevelMap));
+        }
+
+        // Sort workers by tick group and tick level, stable sort
+        // preserves insertion order of workers within the same level
+
+        WorkerLevels.StableSort(
+            [](const TPair<FPSGWTTaskWorker, int32>& A, const TPair<FPSGWTTaskWorker, int32>& B)
+            {
+                const int32 GroupA = A.Key->GetTickGroup();
+                const int32 GroupB = B.Key->GetTickGroup();
+                return (GroupA != GroupB) ? (GroupA < GroupB) : (A.Value < B.Value);
+            } );
+
+        TickOrder.Reserve(WorkerLevels.Num());
+
+        for (int32 i=0; i<WorkerLevels.Num(); ++i)
+        {
+            const TPair<FPSGWTTaskWorker, int32>& WorkerLevel(WorkerLevels[i]);
+
+            if (i == 0
+                || WorkerLevels[i-1].Key->GetTickGroup() != WorkerLevel.Key->GetTickGroup()
+                || WorkerLevels[i-1].Value != WorkerLevel.Value)
+            {
+                TickLevelOffsets.Emplace(i);
+            }
+
+            TickOrder.Emplace(WorkerLevel.Key);
+        }
+
+        TickLevelOffsets.Emplace(TickOrder.Num());
+    }
+
+    int32 ResolveTickLevel(const IGWTTaskWorker& Worker, TMap<const IGWTTaskWorker*, int32>& TickLevelMap)
+    {
+        static const int32 VisitingLevel = -2;
+
+        int32& CachedLevel(TickLevelMap.FindChecked(&Worker));
+
+        if (CachedLevel >= 0)
+        {
+            return CachedLevel;
+        }
+        else if (CachedLevel == VisitingLevel)
+        {
+            UE_LOG(LogGWT, Warning, TEXT("FGWTAsyncThread::ResolveTickLevel() - Cyclic tick prerequisite found on task worker %d, prerequisite ignored"), Worker._TaskWorkerId);
+            return -1;
+        }
+
+        CachedLevel = VisitingLevel;
+
+        int32 TickLevel = 0;
+
+        for (const FPWGWTTaskWorker& PrerequisitePtr : Worker.GetTickPrerequisites())
+        {
+            FPSGWTTaskWorker Prerequisite( PrerequisitePtr.Pin() );
+
+            // Only prerequisites within the same thread and tick group
+            // affect tick level, earlier tick groups always tick first
+            if (Prerequisite.IsValid()
+                && Prerequisite->GetTickGroup() == Worker.GetTickGroup()
+                && TickLevelMap.Contains(Prerequisite.Get()))
+            {
+                TickLevel = FMath::Max(TickLevel, ResolveTickLevel(*Prerequisite, TickLevelMap) + 1);
+                Prerequisite->_bHasTickDependents = true;
+            }
+        }
+
+        CachedLevel = TickLevel;
+
+        return TickLevel;
+    }
+
+    void EnqueueWorkerCommand(FWorkerCommand&& Command)
+    {
+        if (Command.Latch)
+        {
+            Command.Latch->AddPending();
+        }
+
+        WorkerCommands.Enqueue(MoveTemp(Command));
+
+        // Thread is no longer running, resolve commands on the calling thread.
+        // Command enqueued before the thread has been halted is resolved by
+        // the stopping thread.
+        if (bIsThreadHalted)
+        {
+            FScopeLock HaltedScopeLock(&HaltedCommandLock);
+            ProcessWorkerCommands();
+        }
+        else
+        {
+            Wake();
+        }
+    }
+
+    void ProcessWorkerCommands()
+    {
+        FWorkerCommand Command;
+
+        while (WorkerCommands.Dequeue(Command))
+        {
+            switch (Command.Type)
+            {
+                case EWorkerCommand::Add:
+                    if (bIsThreadHalted)
+                    {
+                        UE_LOG(LogGWT, Warning, TEXT("FGWTAsyncThread::ProcessWorkerCommands() - Thread has stopped, %d task worker(s) not added"), Command.Workers.Num());
+                        break;
+                    }
+
+                    for (const FPWGWTTaskWorker& Worker : Command.Workers)
+                    {
+                        RegisterWorker(Worker, true);
+                    }
+                    break;
+
+                case EWorkerCommand::Remove:
+                    for (const FPWGWTTaskWorker& Worker : Command.Workers)
+                    {
+                        FGWTAsyncThread* OwningThread = UnregisterWorker(Worker, Command);
+
+                        // Worker has been migrated or isolated, forward removal
+                        if (OwningThread)
+                        {
+                            FWorkerCommand ForwardCommand(EWorkerCommand::Remove, Command.Latch);
+                            ForwardCommand.Workers.Emplace(Worker);
+                            ForwardCommand.RemovalPromise = MoveTemp(Command.RemovalPromise);
+                            OwningThread->EnqueueWorkerCommand(MoveTemp(ForwardCommand));
+                        }
+                    }
+                    break;
+
+                case EWorkerCommand::MigrateOut:
+                    if (bIsThreadHalted)
+                    {
+                        break;
+                    }
+
+                    if (Command.Workers.Num() > 0)
+                    {
+                        MigrateOutWorkers(Command.Workers, Command.TargetThread, Command.Latch);
+                    }
+                    else
+                    {
+                        MigrateOutWorkers(Command.MigrationCost, Command.TargetThread);
+                    }
+                    break;
+
+                case EWorkerCommand::Adopt:
+                    for (const FPWGWTTaskWorker& Worker : Command.Workers)
+                    {
+                        if (bIsThreadHalted)
+                        {
+                            ReleaseAdoptedWorker(Worker);
+                        }
+                        else
+                        {
+                            RegisterWorker(Worker, false);
+                        }
+                    }
+                    break;
+
+                case EWorkerCommand::AddTypedList:
+                    if (bIsThreadHalted)
+                    {
+                        UE_LOG(LogGWT, Warning, TEXT("FGWTAsyncThread::ProcessWorkerCommands() - Thread has stopped, typed worker list not added"));
+                        break;
+                    }
+
+                    TypedWorkerLists.AddUnique(Command.TypedList);
+                    break;
+
+                case EWorkerCommand::RemoveTypedList:
+                    TypedWorkerLists.Remove(Command.TypedList);
+                    break;
+            }
+
+            // Resolve completion of the processed command only
+
+            if (Command.Latch)
+            {
+                Command.Latch->Release();
+            }
+
+            if (Command.RemovalPromise.IsValid())
+            {
+                Command.RemovalPromise->SetValue();
+            }
+        }
+    }
+
+    void RegisterWorker(const FPWGWTTaskWorker& pWorker, bool bSetupWorker)
+    {
+        FPSGWTTaskWorker Worker( pWorker.Pin() );
+
+        if (! Worker.IsValid())
+        {
+            return;
+        }
+
+        // New workers must be unregistered, adopted workers must be in handoff
+        FGWTAsyncThread* const ExpectedOwner = bSetupWorker ? nullptr : GetMigratingMarker();
+        FGWTAsyncThread* PrevOwner = CompareExchangeOwningThread(*Worker, this, ExpectedOwner);
+
+        // Removal is being requested, wait for it to be published
+        while (PrevOwner == GetRemovalClaimMarker())
+        {
+            FPlatformProcess::Yield();
+            PrevOwner = CompareExchangeOwningThread(*Worker, this, ExpectedOwner);
+        }
+
+        if (PrevOwner == GetRemovalPendingMarker() && ! bSetupWorker)
+        {
+            ApplyPendingRemoval(*Worker);
+            return;
+        }
+        else if (PrevOwner != ExpectedOwner)
+        {
+            UE_CLOG(PrevOwner != this, LogGWT, Warning, TEXT("FGWTAsyncThread::RegisterWorker() - Task worker %d is already registered on another thread"), Worker->_TaskWorkerId);
+            return;
+        }
+
+        WorkerList.AddTail(pWorker);
+        FPlatformAtomics::InterlockedIncrement(&WorkerCount);
+
+        Worker->_WorkerListNode = WorkerList.GetTail();
+        Worker->_TaskWorkerId = _UniqueWorkerId++;
+        bTickScheduleDirty = true;
+
+        // Adopted workers keep their tick time state
+        if (bSetupWorker)
+        {
+            Worker->_LastTickTime = FPlatformTime::Seconds();
+            Worker->_TickTimeAccumulator = 0.0;
+            Worker->_AverageTickCost = 0.0;
+            Worker->SetupTaskWorker();
+        }
+    }
+
+    void MigrateOutWorkers(double MaxTickCost, const FPWGWTAsyncThread& pTargetThread)
+    {
+        FPSGWTAsyncThread TargetThread( pTargetThread.Pin() );
+
+        if (! TargetThread.IsValid() || TargetThread.Get() == this || MaxTickCost <= 0.0)
+        {
+            return;
+        }
+
+        TArray<FPSGWTTaskWorker> Candidates;
+
+        for (const FPWGWTTaskWorker& pWorker : WorkerList)
+        {
+            FPSGWTTaskWorker Worker( pWorker.Pin() );
+
+            if (Worker.IsValid() && Worker->IsMigratable())
+            {
+                Candidates.Emplace(MoveTemp(Worker));
+            }
+        }
+
+        Candidates.Sort(
+            [](const FPSGWTTaskWorker& A, const FPSGWTTaskWorker& B)
+            {
+                return A->_AverageTickCost > B->_AverageTickCost;
+            } );
+
+        // Greedily pick most expensive workers that fit the cost budget
+
+        FWorkerCommand AdoptCommand(EWorkerCommand::Adopt, nullptr);
+        double RemainingCost = MaxTickCost;
+
+        for (const FPSGWTTaskWorker& Worker : Candidates)
+        {
+            if (Worker->_AverageTickCost <= RemainingCost)
+            {
+                RemainingCost -= Worker->_AverageTickCost;
+
+                DetachWorker(*Worker, true);
+                AdoptCommand.Workers.Emplace(Worker);
+            }
+        }
+
+        if (AdoptCommand.Workers.Num() > 0)
+        {
+            bTickScheduleDirty = true;
+            TargetThread->EnqueueWorkerCommand(MoveTemp(AdoptCommand));
+        }
+    }
+
+    // Workers no longer owned by the thread are skipped
+    void MigrateOutWorkers(const TArray<FPWGWTTaskWorker, TInlineAllocator<1>>& Workers, const FPWGWTAsyncThread& pTargetThread, FGWTWorkerLatch* Latch)
+    {
+        FPSGWTAsyncThread TargetThread( pTargetThread.Pin() );
+
+        if (! TargetThread.IsValid() || TargetThread.Get() == this)
+        {
+            return;
+        }
+
+        FWorkerCommand AdoptCommand(EWorkerCommand::Adopt, Latch);
+
+        for (const FPWGWTTaskWorker& pWorker : Workers)
+        {
+            FPSGWTTaskWorker Worker( pWorker.Pin() );
+
+            if (Worker.IsValid() && ReadOwningThread(*Worker) == this && Worker->IsMigratable())
+            {
+                DetachWorker(*Worker, true);
+                AdoptCommand.Workers.Emplace(Worker);
+            }
+        }
+
+        if (AdoptCommand.Workers.Num() > 0)
+        {
+            bTickScheduleDirty = true;
+            TargetThread->EnqueueWorkerCommand(MoveTemp(AdoptCommand));
+        }
+    }
+
+    void UpdateAverageLoopTime(double LoopTime)
+    {
+        // Exponential moving average, alpha 1/8
+        const int32 LoopTimeUsec = static_cast<int32>(FMath::Min(LoopTime * 1e6, static_cast<double>(MAX_int32)));
+        const int32 AverageUsec = FPlatformAtomics::AtomicRead(&AverageLoopTimeUsec);
+        FPlatformAtomics::InterlockedExchange(&AverageLoopTimeUsec, AverageUsec + (LoopTimeUsec - AverageUsec) / 8);
+    }
+
+    // Returns the owning thread if the worker is registered on another thread.
+    // Removal of a worker handed between threads is deferred to the adopting
+    // thread, taking over the command removal promise.
+    FGWTAsyncThread* UnregisterWorker(const FPWGWTTaskWorker& pWorker, FWorkerCommand& Command)
+    {
+        FPSGWTTaskWorker Worker( pWorker.Pin() );
+
+        // Expired workers are removed on the next schedule build
+        if (! Worker.IsValid())
+        {
+            return nullptr;
+        }
+
+        for (;;)
+        {
+            FGWTAsyncThread* OwningThread = ReadOwningThread(*Worker);
+
+            if (OwningThread == this)
+            {
+                // Worker is shut down while still owned by the thread
+                Worker->ShutdownTaskWorker();
+                Worker->_TaskWorkerId = -1;
+
+                DetachWorker(*Worker);
+
+                return nullptr;
+            }
+            else if (OwningThread == GetMigratingMarker())
+            {
+                // Retry if the worker has been adopted in the meantime
+                if (DeferWorkerRemoval(*Worker, Command))
+                {
+                    return nullptr;
+                }
+            }
+            else if (OwningThread == GetRemovalClaimMarker() || OwningThread == GetRemovalPendingMarker())
+            {
+                // Removal has already been requested during the handoff
+                return nullptr;
+            }
+            else
+            {
+                return OwningThread;
+            }
+        }
+    }
+
+    // Removes worker from the worker list without shutting it down,
+    // migrating workers are marked as being handed to another thread
+    void DetachWorker(IGWTTaskWorker& Worker, bool bMigrating = false)
+    {
+        check(Worker._OwningThread == this);
+
+        WorkerList.RemoveNode(Worker._WorkerListNode);
+        FPlatformAtomics::InterlockedDecrement(&WorkerCount);
+        bTickScheduleDirty = true;
+
+        Worker._WorkerListNode = nullptr;
+        FPlatformAtomics::InterlockedExchangePtr((void**)&Worker._OwningThread, bMigrating ? GetMigratingMarker() : nullptr);
+    }
+
+    // Worker Handoff
+    //
+    // While a worker is handed between threads its owning thread holds the
+    // migrating marker. Removal requested during the handoff claims the
+    // worker, publishes the pending removal and is applied by the adopting
+    // thread, or on worker destruction if the worker is never adopted.
+
+    static FORCEINLINE FGWTAsyncThread* GetMigratingMarker()
+    {
+        return reinterpret_cast<FGWTAsyncThread*>(1);
+    }
+
+    static FORCEINLINE FGWTAsyncThread* GetRemovalClaimMarker()
+    {
+        return reinterpret_cast<FGWTAsyncThread*>(2);
+    }
+
+    static FORCEINLINE FGWTAsyncThread* GetRemovalPendingMarker()
+    {
+        return reinterpret_cast<FGWTAsyncThread*>(3);
+    }
+
+    static FORCEINLINE FGWTAsyncThread* CompareExchangeOwningThread(IGWTTaskWorker& Worker, FGWTAsyncThread* Exchange, FGWTAsyncThread* Comparand)
+    {
+        return (FGWTAsyncThread*) FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Worker._OwningThread, Exchange, Comparand);
+    }
+
+    static FORCEINLINE FGWTAsyncThread* ReadOwningThread(IGWTTaskWorker& Worker)
+    {
+        return CompareExchangeOwningThread(Worker, nullptr, nullptr);
+    }
+
+    bool DeferWorkerRemoval(IGWTTaskWorker& Worker, FWorkerCommand& Command)
+    {
+        if (CompareExchangeOwningThread(Worker, GetRemovalClaimMarker(), GetMigratingMarker()) != GetMigratingMarker())
+        {
+            return false;
+        }
+
+        FGWTWorkerLatch* Latch = Command.Latch;
+        FPSRemovalPromise RemovalPromise( MoveTemp(Command.RemovalPromise) );
+
+        // Latch is released by the adopting thread in addition to the command
+        if (Latch)
+        {
+            Latch->AddPending();
+        }
+
+        Worker._PendingRemoval = [Latch, RemovalPromise]()
+        {
+            if (Latch)
+            {
+                Latch->Release();
+            }
+
+            if (RemovalPromise.IsValid())
+            {
+                RemovalPromise->SetValue();
+            }
+        };
+
+        FPlatformAtomics::InterlockedExchangePtr((void**)&Worker._OwningThread, GetRemovalPendingMarker());
+
+        return true;
+    }
+
+    // Shuts down worker handed to a halted thread as if its removal had been
+    // requested during the handoff, the worker is never ticked again
+    void ReleaseAdoptedWorker(const FPWGWTTaskWorker& pWorker)
+    {
+        FPSGWTTaskWorker Worker( pWorker.Pin() );
+
+        if (! Worker.IsValid())
+        {
+            return;
+        }
+
+        FWorkerCommand RemoveCommand(EWorkerCommand::Remove, nullptr);
+        DeferWorkerRemoval(*Worker, RemoveCommand);
+
+        // Concurrent removal may still be publishing its claim
+        FGWTAsyncThread* OwningThread = ReadOwningThread(*Worker);
+
+        while (OwningThread == GetRemovalClaimMarker())
+        {
+            FPlatformProcess::Yield();
+            OwningThread = ReadOwningThread(*Worker);
+        }
+
+        if (OwningThread == GetRemovalPendingMarker())
+        {
+            ApplyPendingRemoval(*Worker);
+        }
+    }
+
+    // Shuts down adopted worker whose removal has been requested during the handoff
+    void ApplyPendingRemoval(IGWTTaskWorker& Worker)
+    {
+        TFunction<void()> PendingRemoval( MoveTemp(Worker._PendingRemoval) );
+        Worker._PendingRemoval = nullptr;
+
+        // Adopting thread owns the worker for the duration of its shutdown
+        FPlatformAtomics::InterlockedExchangePtr((void**)&Worker._OwningThread, this);
+
+        Worker.ShutdownTaskWorker();
+        Worker._TaskWorkerId = -1;
+
+        FPlatformAtomics::InterlockedExchangePtr((void**)&Worker._OwningThread, nullptr);
+
+        if (PendingRemoval)
+        {
+            PendingRemoval();
+        }
+    }
+
+    // May be called from tick thread pool threads
+    void CheckTickBudget(const FPSGWTTaskWorker& Worker, double TickCost)
+    {
+        if (TickCost <= Worker->TickBudget)
+        {
+            Worker->_ConsecutiveOverrunCount = 0;
+            return;
+        }
+
+        ++Worker->_OverrunCount;
+        ++Worker->_ConsecutiveOverrunCount;
+
+        UE_LOG(LogGWT, Verbose, TEXT("FGWTAsyncThread::CheckTickBudget() - %s tick overrun, %.3f ms of %.3f ms budget (%d overruns)"),
+            *Worker->GetWorkerName(),
+            TickCost * 1000.0,
+            Worker->TickBudget * 1000.0,
+            Worker->_OverrunCount);
+
+        if (Worker->_ConsecutiveOverrunCount < OverrunPolicy.ChronicOverrunCount)
+        {
+            return;
+        }
+
+        Worker->_ConsecutiveOverrunCount = 0;
+
+        const bool bIsolate = OverrunPolicy.Action == EGWTOverrunAction::Isolate
+            && IsolateWorkerCallback
+            && Worker->IsMigratable();
+
+        if (bIsolate)
+        {
+            UE_LOG(LogGWT, Warning, TEXT("FGWTAsyncThread::CheckTickBudget() - %s exceeded its %.3f ms tick budget %d consecutive times, isolating worker"),
+                *Worker->GetWorkerName(),
+                Worker->TickBudget * 1000.0,
+                OverrunPolicy.ChronicOverrunCount);
+
+            PendingIsolations.Enqueue(Worker);
+        }
+        else if (OverrunPolicy.Action != EGWTOverrunAction::None && Worker->TickInterval < OverrunPolicy.MaxTickInterval)
+        {
+            Worker->TickInterval = FMath::Min(Worker->TickInterval * 2, OverrunPolicy.MaxTickInterval);
+
+            UE_LOG(LogGWT, Warning, TEXT("FGWTAsyncThread::CheckTickBudget() - %s exceeded its %.3f ms tick budget %d consecutive times, tick interval demoted to %d"),
+                *Worker->GetWorkerName(),
+                Worker->TickBudget * 1000.0,
+                OverrunPolicy.ChronicOverrunCount,
+                Worker->TickInterval);
+        }
+        else
+        {
+            UE_LOG(LogGWT, Warning, TEXT("FGWTAsyncThread::CheckTickBudget() - %s exceeded its %.3f ms tick budget %d consecutive times"),
+                *Worker->GetWorkerName(),
+                Worker->TickBudget * 1000.0,
+                OverrunPolicy.ChronicOverrunCount);
+        }
+    }
+
+    void ProcessPendingIsolations()
+    {
+        FPWGWTTaskWorker pWorker;
+
+        while (PendingIsolations.Dequeue(pWorker))
+        {
+            FPSGWTTaskWorker Worker( pWorker.Pin() );
+
+            // Worker is only detached once the isolation thread takes it,
+            // ignored isolation requests leave the worker on the thread
+            if (Worker.IsValid() && ReadOwningThread(*Worker) == this)
+            {
+                IsolateWorkerCallback(*this, Worker);
+            }
         }
     }
 };
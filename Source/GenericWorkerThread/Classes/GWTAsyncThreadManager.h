@@ -77,14 +77,40 @@ class GENERICWORKERTHREAD_API FGWTAsyncThreadManager
     struct FThreadPoolRegister
     {
         TMap<int32, FPWGWTAsyncThreadPool> InstanceMap;
+        TMap<FName, FPSGWTAsyncThreadPool> NamedInstanceMap;
         int32 UniqueID = 0;
     };
 
     FThreadRegister ThreadRegister;
     FThreadPoolRegister ThreadPoolRegister;
 
+    double BalanceTargetLoopTime = 0.0;
+    FDelegateHandle BalanceTickerHandle;
+
+    bool TickLoadBalancing(float DeltaTime);
+
+    struct FIsolationThread
+    {
+        FPSGWTAsyncThread AsyncThread;
+        TUniquePtr<FGWTWorkerLatch> AdoptLatch;
+    };
+
+    TArray<FIsolationThread> IsolationThreads;
+
+    void IsolateWorker(const FPWGWTTaskWorker& Worker, const FPWGWTAsyncThread& SourceThread);
+    void PruneIsolationThreads();
+
+    float WatchdogStallFactor = 4.f;
+    double WatchdogMinStallTime = 0.1;
+    FDelegateHandle WatchdogTickerHandle;
+    TSet<int32> StalledThreads;
+
+    bool TickWatchdog(float DeltaTime);
+
 public:
 
+    ~FGWTAsyncThreadManager();
+
     // Thread Functions
 
     FPSGWTAsyncThread CreateThread(float InRestTime, int32& OutInstanceId);
@@ -96,6 +122,44 @@ public:
         return ThreadRegister.InstanceMap.Contains(InstanceId);
     }
 
+    // Load Balancing
+
+    // Periodically migrates workers from the busiest thread to the least
+    // busy thread while the busiest thread average loop time exceeds the
+    // target loop time. Game thread only.
+    void EnableLoadBalancing(double TargetLoopTime, float BalanceInterval = 1.f);
+    void DisableLoadBalancing();
+
+    FORCEINLINE bool IsLoadBalancingEnabled() const
+    {
+        return BalanceTickerHandle.IsValid();
+    }
+
+    // Requests a single migration step between the busiest and the least
+    // busy started threads. Returns true if a migration has been requested.
+    bool BalanceThreads(double TargetLoopTime);
+
+    // Watchdog
+    //
+    // Flags and logs threads whose current loop tick has not completed
+    // within stall factor times the thread expected loop period, which is
+    // the thread rest time plus its average loop time, or within the
+    // minimum stall time if that is longer. Game thread only.
+
+    void EnableWatchdog(float StallFactor = 4.f, float CheckInterval = .5f, double MinStallTime = .1);
+    void DisableWatchdog();
+
+    FORCEINLINE bool IsThreadStalled(int32 InstanceId) const
+    {
+        return StalledThreads.Contains(InstanceId);
+    }
+
+    // Number of threads created to host isolated chronic overrun workers
+    FORCEINLINE int32 GetIsolationThreadCount() const
+    {
+        return IsolationThreads.Num();
+    }
+
     // Thread Pool Functions
 
     FPSGWTAsyncThreadPool CreateThreadPool(int32 ThreadCount, int32& OutInstanceId);
@@ -106,4 +170,15 @@ public:
     {
         return ThreadPoolRegister.InstanceMap.Contains(InstanceId);
     }
+
+    // Named thread pools are owned by the manager and persist until removed
+
+    FPSGWTAsyncThreadPool FindOrCreateNamedThreadPool(FName PoolName, int32 ThreadCount);
+    FPSGWTAsyncThreadPool GetNamedThreadPool(FName PoolName) const;
+    bool RemoveNamedThreadPool(FName PoolName);
+
+    FORCEINLINE bool HasNamedThreadPool(FName PoolName) const
+    {
+        return ThreadPoolRegister.NamedInstanceMap.Contains(PoolName);
+    }
 };
@@ -29,51 +29,790 @@
 
 #include "CoreMinimal.h"
 #include "Async.h"
+#include "Misc/IQueuedWork.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter64.h"
 #include "GWTAsyncTypes.h"
+#include "GWTCacheLine.h"
+#include "GWTExecutor.h"
+#include "GWTIdlePolicy.h"
+#include "GWTLatencyHistogram.h"
+#include "GWTTaskRecorder.h"
+#include "GWTTrace.h"
 #include "GWTAsyncThreadPool.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FGWTAsyncTaskObject_OnTaskDone);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FGWTAsyncTaskObject_OnTaskCancelled);
+
+UENUM(BlueprintType)
+enum class EGWTAsyncTaskState : uint8
+{
+    Idle,
+    Queued,
+    Running,
+    Done,
+    Cancelled
+};
+
+// Task state shared between the task owner and the task completion callbacks.
+// All state access is atomic, state changes are performed through transitions.
+// Padded on both sides, keeping the state apart from the shared reference
+// count allocated alongside it, which is modified whenever task callbacks
+// are copied. Waiters block on a lazily created event, triggered whenever
+// the state leaves the queued or running state.
+struct FGWTAsyncTaskState
+{
+    FGWTAsyncTaskState()
+        : State(static_cast<int32>(EGWTAsyncTaskState::Idle))
+        , WaiterCount(0)
+        , ResolveEvent(nullptr)
+    {
+    }
+
+    ~FGWTAsyncTaskState()
+    {
+        if (ResolveEvent)
+        {
+            FPlatformProcess::ReturnSynchEventToPool(ResolveEvent);
+        }
+    }
+
+    FGWTAsyncTaskState(const FGWTAsyncTaskState&) = delete;
+    FGWTAsyncTaskState& operator=(const FGWTAsyncTaskState&) = delete;
+
+    FORCEINLINE EGWTAsyncTaskState Get() const
+    {
+        return static_cast<EGWTAsyncTaskState>(FPlatformAtomics::AtomicRead(&State));
+    }
+
+    FORCEINLINE bool IsPending() const
+    {
+        const EGWTAsyncTaskState TaskState = Get();
+        return TaskState == EGWTAsyncTaskState::Queued || TaskState == EGWTAsyncTaskState::Running;
+    }
+
+    FORCEINLINE void Set(EGWTAsyncTaskState InState)
+    {
+        FPlatformAtomics::InterlockedExchange(&State, static_cast<int32>(InState));
+        NotifyWaiters(InState);
+    }
+
+    FORCEINLINE bool Transition(EGWTAsyncTaskState FromState, EGWTAsyncTaskState ToState)
+    {
+        const int32 From = static_cast<int32>(FromState);
+        const int32 To   = static_cast<int32>(ToState);
+
+        if (FPlatformAtomics::InterlockedCompareExchange(&State, To, From) == From)
+        {
+            NotifyWaiters(ToState);
+            return true;
+        }
+
+        return false;
+    }
+
+    // Blocks until the state is neither queued nor running. Pending work of
+    // the wait helper is executed meanwhile, the wait wakes periodically to
+    // pick up newly queued work.
+    void Wait(IGWTWaitHelper* WaitHelper)
+    {
+        if (! IsPending())
+        {
+            return;
+        }
+
+        FPlatformAtomics::InterlockedIncrement(&WaiterCount);
+
+        // Notifiers skip the trigger until the event is published,
+        // the state is checked again once the event is published
+        if (! ResolveEvent)
+        {
+            FEvent* NewEvent = FPlatformProcess::GetSynchEventFromPool(false);
+
+            if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&ResolveEvent, NewEvent, nullptr) != nullptr)
+            {
+                FPlatformProcess::ReturnSynchEventToPool(NewEvent);
+            }
+        }
+
+        while (IsPending())
+        {
+            if (! WaitHelper || ! WaitHelper->TryExecuteQueuedWork())
+            {
+                ResolveEvent->Wait(FTimespan::FromMicroseconds(200));
+            }
+        }
+
+        FPlatformAtomics::InterlockedDecrement(&WaiterCount);
+    }
+
+private:
+
+    GWT_CACHE_PAD;
+    volatile int32 State;
+    GWT_CACHE_PAD;
+
+    volatile int32 WaiterCount;
+    FEvent* volatile ResolveEvent;
+
+    FORCEINLINE void NotifyWaiters(EGWTAsyncTaskState InState)
+    {
+        if (InState == EGWTAsyncTaskState::Queued
+            || InState == EGWTAsyncTaskState::Running
+            || FPlatformAtomics::AtomicRead(&WaiterCount) == 0)
+        {
+            return;
+        }
+
+        FEvent* Event = ResolveEvent;
+
+        // Auto reset event, additional waiters wake on their wait timeout
+        if (Event)
+        {
+            Event->Trigger();
+        }
+    }
+};
+
+typedef TSharedRef<FGWTAsyncTaskState, ESPMode::ThreadSafe> FPRGWTAsyncTaskState;
 
 typedef TSharedRef<class FGWTAsyncThreadPool> FPRGWTAsyncThreadPool;
 typedef TSharedPtr<class FGWTAsyncThreadPool> FPSGWTAsyncThreadPool;
 typedef TWeakPtr<class FGWTAsyncThreadPool>   FPWGWTAsyncThreadPool;
 
-class FGWTAsyncThreadPool
+enum class EGWTTaskPriority : uint8
+{
+    High,
+    Normal,
+    Low
+};
+
+// Behaviour on optional work that is not expected to meet its deadline
+enum class EGWTDeadlinePolicy : uint8
+{
+    // Execute work regardless of its deadline
+    Keep,
+
+    // Discard work without executing it
+    Shed,
+
+    // Move work to low priority without deadline
+    Downgrade
+};
+
+struct FGWTTaskSchedule
+{
+    EGWTTaskPriority Priority = EGWTTaskPriority::Normal;
+
+    // Absolute deadline in FPlatformTime::Seconds(), non-positive for none
+    double Deadline = 0.0;
+
+    // Optional work may be shed or downgraded once it can no longer meet
+    // its deadline, according to the thread pool deadline policy
+    bool bOptional = false;
+
+    FGWTTaskSchedule() = default;
+
+    FGWTTaskSchedule(EGWTTaskPriority InPriority)
+        : Priority(InPriority)
+    {
+    }
+
+    FORCEINLINE bool HasDeadline() const
+    {
+        return Deadline > 0.0;
+    }
+
+    // Schedule with deadline relative to the current time
+    static FGWTTaskSchedule WithDeadline(double InSeconds, EGWTTaskPriority InPriority = EGWTTaskPriority::Normal, bool bInOptional = false)
+    {
+        FGWTTaskSchedule Schedule(InPriority);
+        Schedule.Deadline = FPlatformTime::Seconds() + FMath::Max(InSeconds, 0.0);
+        Schedule.bOptional = bInOptional;
+        return Schedule;
+    }
+};
+
+template<typename ResultType>
+FORCEINLINE void GWTAbandonPromise(TPromise<ResultType>& Promise)
+{
+    Promise.SetValue(ResultType());
+}
+
+FORCEINLINE void GWTAbandonPromise(TPromise<void>& Promise)
+{
+    Promise.SetValue();
+}
+
+// Function queued work. Unlike TAsyncQueuedWork, abandoned work
+// (dropped or discarded on pool destruction) resolves its future
+// with a default result instead of leaving waiters blocked.
+template<typename ResultType>
+class TGWTAsyncQueuedWork : public IQueuedWork
+{
+    TFunction<ResultType()> Function;
+    TPromise<ResultType> Promise;
+
+public:
+
+    TGWTAsyncQueuedWork(TFunction<ResultType()>&& InFunction, TPromise<ResultType>&& InPromise)
+        : Function(MoveTemp(InFunction))
+        , Promise(MoveTemp(InPromise))
+    {
+    }
+
+    virtual void DoThreadedWork() override
+    {
+        SetPromise(Promise, Function);
+        delete this;
+    }
+
+    virtual void Abandon() override
+    {
+        GWTAbandonPromise(Promise);
+        delete this;
+    }
+};
+
+// Cooperative cancellation flag, checked by work that may be cancelled
+// once its result is no longer required
+class FGWTCancellationToken
+{
+    volatile int32 bCancelled;
+
+public:
+
+    FGWTCancellationToken()
+        : bCancelled(0)
+    {
+    }
+
+    FORCEINLINE bool IsCancelled() const
+    {
+        return FPlatformAtomics::AtomicRead(&bCancelled) != 0;
+    }
+
+    // Returns true if the token has not been cancelled before
+    FORCEINLINE bool Cancel()
+    {
+        return FPlatformAtomics::InterlockedExchange(&bCancelled, 1) == 0;
+    }
+};
+
+// Shared state of speculative work alternatives. The first alternative
+// to complete resolves the promise and cancels the remaining alternatives,
+// the promise is resolved with a default result if every alternative
+// finishes without producing a result.
+template<typename ResultType>
+class TGWTSpeculativeState
+{
+    TPromise<ResultType> Promise;
+    volatile int32 bResolved;
+    volatile int32 PendingCount;
+    volatile int32 StartedCount;
+
+public:
+
+    FGWTCancellationToken Token;
+
+    TGWTSpeculativeState(int32 InPendingCount, TFunction<void()>&& CompletionCallback)
+        : Promise(MoveTemp(CompletionCallback))
+        , bResolved(0)
+        , PendingCount(InPendingCount)
+        , StartedCount(0)
+    {
+    }
+
+    FORCEINLINE TFuture<ResultType> GetFuture()
+    {
+        return Promise.GetFuture();
+    }
+
+    // Whether an alternative may start. Hedged alternatives only start
+    // if no other alternative has started yet.
+    bool TryStart(bool bHedged)
+    {
+        if (Token.IsCancelled())
+        {
+            return false;
+        }
+
+        // Single compare exchange, concurrent hedges cannot both start
+        if (bHedged)
+        {
+            return FPlatformAtomics::InterlockedCompareExchange(&StartedCount, 1, 0) == 0;
+        }
+
+        FPlatformAtomics::InterlockedIncrement(&StartedCount);
+        return true;
+    }
+
+    void Resolve(ResultType&& Result)
+    {
+        if (FPlatformAtomics::InterlockedCompareExchange(&bResolved, 1, 0) == 0)
+        {
+            Token.Cancel();
+            Promise.SetValue(MoveTemp(Result));
+        }
+    }
+
+    void Finish()
+    {
+        if (FPlatformAtomics::InterlockedDecrement(&PendingCount) == 0
+            && FPlatformAtomics::InterlockedCompareExchange(&bResolved, 1, 0) == 0)
+        {
+            GWTAbandonPromise(Promise);
+        }
+    }
+
+    // Resolves promise with a default result without waiting for pending
+    // alternatives, remaining alternatives are cancelled
+    void Abandon()
+    {
+        FPlatformAtomics::InterlockedExchange(&PendingCount, 0);
+        Token.Cancel();
+
+        if (FPlatformAtomics::InterlockedCompareExchange(&bResolved, 1, 0) == 0)
+        {
+            GWTAbandonPromise(Promise);
+        }
+    }
+};
+
+template<typename ResultType>
+class TGWTSpeculativeWork : public IQueuedWork
+{
+public:
+
+    typedef TFunction<ResultType(const FGWTCancellationToken&)> FFunction;
+    typedef TSharedRef<TGWTSpeculativeState<ResultType>, ESPMode::ThreadSafe> FStateRef;
+
+    TGWTSpeculativeWork(const FFunction& InFunction, const FStateRef& InState, bool bInHedged = false)
+        : Function(InFunction)
+        , State(InState)
+        , bHedged(bInHedged)
+    {
+    }
+
+    virtual void DoThreadedWork() override
+    {
+        if (State->TryStart(bHedged))
+        {
+            ResultType Result(Function(State->Token));
+
+            // Result of cancelled alternative is discarded
+            if (! State->Token.IsCancelled())
+            {
+                State->Resolve(MoveTemp(Result));
+            }
+        }
+
+        State->Finish();
+        delete this;
+    }
+
+    virtual void Abandon() override
+    {
+        State->Finish();
+        delete this;
+    }
+
+private:
+
+    FFunction Function;
+    FStateRef State;
+    bool bHedged;
+};
+
+// Thread pool with its own worker threads and work queue.
+//
+// Queued work is ordered by priority, then earliest deadline first, then
+// submission order. Work without deadline is executed after work with
+// deadline of the same priority.
+//
+// The queue may be bounded, submissions over capacity are then handled
+// according to the queue overflow policy.
+//
+// Delayed work is held outside of the queue and promoted to the queue once
+// its delay has elapsed, either by a worker thread dequeuing work or by a
+// parked worker thread waking up on the earliest delayed work issue time.
+class GENERICWORKERTHREAD_API FGWTAsyncThreadPool
+    : public IGWTWaitHelper
+    , public IGWTExecutor
 {
-    FQueuedThreadPool* const ThreadPool;
+    class FWorkerThread;
+    class FScheduledWork;
+    class FExecutorWork;
+
+    struct FQueuedEntry
+    {
+        IQueuedWork* Work;
+        uint64 Sequence;
+        double Deadline;
+        double EnqueueTime;
+        EGWTTaskPriority Priority;
+        bool bOptional;
+
+        FORCEINLINE bool operator<(const FQueuedEntry& Other) const
+        {
+            if (Priority != Other.Priority)
+            {
+                return Priority < Other.Priority;
+            }
+
+            if (Deadline != Other.Deadline)
+            {
+                return Deadline < Other.Deadline;
+            }
+
+            return Sequence < Other.Sequence;
+        }
+    };
+
+    struct FDelayedEntry
+    {
+        IQueuedWork* Work;
+        double IssueTime;
+        FGWTTaskSchedule Schedule;
+
+        FORCEINLINE bool operator<(const FDelayedEntry& Other) const
+        {
+            return IssueTime < Other.IssueTime;
+        }
+    };
+
+    TArray<FWorkerThread*> WorkerThreads;
+    TArray<FWorkerThread*> ParkedThreads;
     bool bThreadPoolCreated;
 
+    // Queue state guarded by the queue lock
+    GWT_CACHE_PAD;
+    FCriticalSection QueueLock;
+    TArray<FQueuedEntry> QueuedWork;
+    TArray<FDelayedEntry> DelayedWork;
+    uint64 QueueSequence;
+
+    // Queue counters polled by spinning worker threads
+    GWT_CACHE_PAD;
+    volatile int32 DelayedWorkCount;
+    volatile int32 QueuedWorkCount;
+    volatile int32 SpinningThreadCount;
+    FThreadSafeBool bIsStopping;
+
+    // Configuration
+    GWT_CACHE_PAD;
+    FGWTIdlePolicy IdlePolicy;
+    EGWTDeadlinePolicy DeadlinePolicy;
+    int32 QueueCapacity;
+    EGWTQueueOverflowPolicy OverflowPolicy;
+
+    // Statistics updated on each work completion
+    GWT_CACHE_PAD;
+    volatile int32 AverageWorkTimeUsec;
+    FThreadSafeCounter DeadlineMissCount;
+    FThreadSafeCounter ShedCount;
+    FThreadSafeCounter DowngradeCount;
+    FThreadSafeCounter64 CompletedWorkCount;
+    FGWTLatencyHistogram LatencyHistogram;
+
+    // Statistics updated on enqueue
+    GWT_CACHE_PAD;
+    volatile int32 PeakQueueDepth;
+    FThreadSafeCounter RejectedCount;
+    FThreadSafeCounter DroppedCount;
+    FThreadSafeCounter InlineCount;
+    GWT_CACHE_PAD;
+
+    FQueuedEntry MakeEntry(IQueuedWork* Work, const FGWTTaskSchedule& Schedule);
+
 public:
 
-    FGWTAsyncThreadPool()
-        : ThreadPool(FQueuedThreadPool::Allocate())
-        , bThreadPoolCreated(false)
+    FGWTAsyncThreadPool();
+    FGWTAsyncThreadPool(int32 InThreadCount);
+    ~FGWTAsyncThreadPool();
+
+    void SetThreadInstanceCount(int32 InThreadCount);
+
+    FORCEINLINE int32 GetThreadInstanceCount() const
     {
+        return WorkerThreads.Num();
     }
 
-    FGWTAsyncThreadPool(int32 InThreadCount)
-        : ThreadPool(FQueuedThreadPool::Allocate())
-        , bThreadPoolCreated(false)
+    // Idle policy applied to worker threads the next time they run out of work
+    FORCEINLINE void SetIdlePolicy(const FGWTIdlePolicy& InIdlePolicy)
     {
-        SetThreadInstanceCount(InThreadCount);
+        IdlePolicy = InIdlePolicy;
     }
 
-    ~FGWTAsyncThreadPool()
+    FORCEINLINE const FGWTIdlePolicy& GetIdlePolicy() const
     {
-        ThreadPool->Destroy();
-        delete ThreadPool;
+        return IdlePolicy;
     }
 
-    void SetThreadInstanceCount(int32 InThreadCount)
+    FORCEINLINE bool HasQueuedWork() const
     {
-        if (bThreadPoolCreated)
+        return FPlatformAtomics::AtomicRead(&QueuedWorkCount) > 0;
+    }
+
+    // Add work to the queue, wakes a parked worker thread if required.
+    // Returns false and leaves work untouched if no worker thread exists
+    // or if the queue is full with reject overflow policy.
+    bool AddQueuedWork(IQueuedWork* Work, const FGWTTaskSchedule& Schedule = FGWTTaskSchedule());
+
+    // Add multiple work to the queue with a single queue lock acquisition,
+    // wakes only as many parked worker threads as there are work that
+    // cannot be picked up by already spinning worker threads.
+    // Returns false and leaves work untouched if no worker thread exists
+    // or if the whole batch does not fit with reject overflow policy.
+    bool AddQueuedWorkBatch(const TArray<IQueuedWork*>& WorkBatch, const FGWTTaskSchedule& Schedule = FGWTTaskSchedule());
+
+    // Queue Capacity
+
+    // Limit queued work count, non-positive capacity for unbounded queue
+    void SetQueueLimit(int32 InCapacity, EGWTQueueOverflowPolicy InOverflowPolicy = EGWTQueueOverflowPolicy::Block)
+    {
+        FScopeLock QueueScopeLock(&QueueLock);
+        QueueCapacity = InCapacity;
+        OverflowPolicy = InOverflowPolicy;
+    }
+
+    FORCEINLINE int32 GetQueueCapacity() const
+    {
+        return QueueCapacity;
+    }
+
+    FORCEINLINE EGWTQueueOverflowPolicy GetQueueOverflowPolicy() const
+    {
+        return OverflowPolicy;
+    }
+
+    FORCEINLINE int32 GetQueueDepth() const
+    {
+        return FPlatformAtomics::AtomicRead(&QueuedWorkCount);
+    }
+
+    FORCEINLINE int32 GetPeakQueueDepth() const
+    {
+        return FPlatformAtomics::AtomicRead(&PeakQueueDepth);
+    }
+
+    FORCEINLINE int32 GetRejectedCount() const
+    {
+        return RejectedCount.GetValue();
+    }
+
+    FORCEINLINE int32 GetDroppedCount() const
+    {
+        return DroppedCount.GetValue();
+    }
+
+    FORCEINLINE int32 GetInlineCount() const
+    {
+        return InlineCount.GetValue();
+    }
+
+    void ResetQueueStats()
+    {
+        FPlatformAtomics::InterlockedExchange(&PeakQueueDepth, GetQueueDepth());
+        RejectedCount.Reset();
+        DroppedCount.Reset();
+        InlineCount.Reset();
+    }
+
+    // Add function with scheduling parameters. Returned future resolves to
+    // false if the work has been shed or abandoned without being executed.
+    TFuture<bool> AddScheduledWork(TFunction<void()> Function, const FGWTTaskSchedule& Schedule, TFunction<void()> CompletionCallback = TFunction<void()>());
+
+    // Delayed Work
+
+    // Add work that is queued once the delay in seconds has elapsed.
+    // Delayed work is not subject to the queue capacity once promoted.
+    // Returns false and leaves work untouched if no worker thread exists.
+    bool AddDelayedWork(IQueuedWork* Work, double Delay, const FGWTTaskSchedule& Schedule = FGWTTaskSchedule());
+
+    FORCEINLINE int32 GetDelayedWorkCount() const
+    {
+        return FPlatformAtomics::AtomicRead(&DelayedWorkCount);
+    }
+
+    // Speculative Work
+
+    // Executes alternative functions concurrently, the returned future
+    // resolves to the result of the first alternative to complete. Remaining
+    // alternatives are cancelled through the cancellation token, alternatives
+    // that have not yet started are skipped. The future resolves to a default
+    // result if every alternative has been abandoned.
+    template<typename ResultType>
+    TFuture<ResultType> AddSpeculativeWork(
+        const TArray<typename TGWTSpeculativeWork<ResultType>::FFunction>& Alternatives,
+        const FGWTTaskSchedule& Schedule = FGWTTaskSchedule(),
+        TFunction<void()> CompletionCallback = TFunction<void()>()
+        )
+    {
+        typedef TGWTSpeculativeState<ResultType> FState;
+
+        if (! bThreadPoolCreated || Alternatives.Num() == 0)
+        {
+            return TFuture<ResultType>();
+        }
+
+        typename TGWTSpeculativeWork<ResultType>::FStateRef State(
+            MakeShared<FState, ESPMode::ThreadSafe>(Alternatives.Num(), MoveTemp(CompletionCallback)));
+
+        TFuture<ResultType> Future(State->GetFuture());
+
+        TArray<IQueuedWork*> WorkBatch;
+        WorkBatch.Reserve(Alternatives.Num());
+
+        for (const typename TGWTSpeculativeWork<ResultType>::FFunction& Alternative : Alternatives)
         {
-            ThreadPool->Destroy();
+            WorkBatch.Emplace(new TGWTSpeculativeWork<ResultType>(Alternative, State));
         }
 
-        bThreadPoolCreated = ThreadPool->Create(InThreadCount, 32 * 1024);
+        // Rejected batch, abandon alternatives to resolve the future
+        if (! AddQueuedWorkBatch(WorkBatch, Schedule))
+        {
+            for (IQueuedWork* Work : WorkBatch)
+            {
+                Work->Abandon();
+            }
+        }
+
+        return Future;
     }
 
+    // Executes function with hedged submission. The function is reissued
+    // with high priority if no issued copy has started once the hedge delay
+    // in seconds has elapsed, up to the max hedge count. The returned future
+    // resolves to the result of the first copy to complete, remaining copies
+    // are cancelled through the cancellation token. The future resolves to a
+    // default result if the work is rejected.
+    template<typename ResultType>
+    TFuture<ResultType> AddHedgedWork(
+        const typename TGWTSpeculativeWork<ResultType>::FFunction& Function,
+        double HedgeDelay,
+        int32 MaxHedgeCount = 1,
+        const FGWTTaskSchedule& Schedule = FGWTTaskSchedule(),
+        TFunction<void()> CompletionCallback = TFunction<void()>()
+        )
+    {
+        typedef TGWTSpeculativeState<ResultType> FState;
+
+        if (! bThreadPoolCreated)
+        {
+            return TFuture<ResultType>();
+        }
+
+        MaxHedgeCount = FMath::Max(MaxHedgeCount, 0);
+
+        typename TGWTSpeculativeWork<ResultType>::FStateRef State(
+            MakeShared<FState, ESPMode::ThreadSafe>(1 + MaxHedgeCount, MoveTemp(CompletionCallback)));
+
+        TFuture<ResultType> Future(State->GetFuture());
+
+        IQueuedWork* Work = new TGWTSpeculativeWork<ResultType>(Function, State);
+
+        // Rejected work, resolve state with a default result without hedging
+        if (! AddQueuedWork(Work, Schedule))
+        {
+            State->Abandon();
+            Work->Abandon();
+            return Future;
+        }
+
+        FGWTTaskSchedule HedgeSchedule(Schedule);
+        HedgeSchedule.Priority = EGWTTaskPriority::High;
+
+        for (int32 i=0; i<MaxHedgeCount; ++i)
+        {
+            IQueuedWork* HedgeWork = new TGWTSpeculativeWork<ResultType>(Function, State, true);
+
+            if (! AddDelayedWork(HedgeWork, HedgeDelay * (i+1), HedgeSchedule))
+            {
+                HedgeWork->Abandon();
+            }
+        }
+
+        return Future;
+    }
+
+    // Work Statistics
+
+    // Number of work executed by the worker threads and wait helpers
+    FORCEINLINE int64 GetCompletedWorkCount() const
+    {
+        return CompletedWorkCount.GetValue();
+    }
+
+    // Histogram of work latency from enqueue to completion
+    FORCEINLINE const FGWTLatencyHistogram& GetLatencyHistogram() const
+    {
+        return LatencyHistogram;
+    }
+
+    // Deadline Scheduling
+
+    FORCEINLINE void SetDeadlinePolicy(EGWTDeadlinePolicy InDeadlinePolicy)
+    {
+        DeadlinePolicy = InDeadlinePolicy;
+    }
+
+    FORCEINLINE EGWTDeadlinePolicy GetDeadlinePolicy() const
+    {
+        return DeadlinePolicy;
+    }
+
+    // Moving average of work execution time, used to
+    // predict whether queued work is able to meet its deadline
+    FORCEINLINE double GetAverageWorkTime() const
+    {
+        return FPlatformAtomics::AtomicRead(&AverageWorkTimeUsec) * 1e-6;
+    }
+
+    // Number of work with deadline completed after its deadline
+    FORCEINLINE int32 GetDeadlineMissCount() const
+    {
+        return DeadlineMissCount.GetValue();
+    }
+
+    FORCEINLINE int32 GetShedCount() const
+    {
+        return ShedCount.GetValue();
+    }
+
+    FORCEINLINE int32 GetDowngradeCount() const
+    {
+        return DowngradeCount.GetValue();
+    }
+
+    void ResetDeadlineStats()
+    {
+        DeadlineMissCount.Reset();
+        ShedCount.Reset();
+        DowngradeCount.Reset();
+    }
+
+    // -- BEGIN IGWTWaitHelper
+
+    virtual bool TryExecuteQueuedWork() override;
+
+    // -- END IGWTWaitHelper
+
+    // -- BEGIN IGWTExecutor
+
+    // Deferred callbacks submitted from the pool worker threads are queued
+    // with low priority, behind work posted by other threads.
+    // Abandoned executor callbacks are discarded without execution.
+
+    virtual bool Post(FExecutorCallback Callback) override;
+    virtual bool Defer(FExecutorCallback Callback) override;
+    virtual bool BulkPost(TArray<FExecutorCallback>&& Callbacks) override;
+    virtual bool IsInExecutorContext() const override;
+
+    // -- END IGWTExecutor
+
+    // Add function work. Returned future resolves to a default result if the
+    // work is rejected or abandoned without being executed.
     template<typename ResultType>
     TFuture<ResultType> AddQueuedWork(TFunction<ResultType()> Function, TFunction<void()> CompletionCallback = TFunction<void()>())
     {
@@ -82,7 +821,13 @@ public:
             TPromise<ResultType> Promise(MoveTemp(CompletionCallback));
             TFuture<ResultType> Future = Promise.GetFuture();
 
-            ThreadPool->AddQueuedWork(new TAsyncQueuedWork<ResultType>(MoveTemp(Function), MoveTemp(Promise)));
+            IQueuedWork* Work = new TGWTAsyncQueuedWork<ResultType>(MoveTemp(Function), MoveTemp(Promise));
+
+            // Rejected work, abandon to resolve the promise
+            if (! AddQueuedWork(Work))
+            {
+                Work->Abandon();
+            }
 
             return MoveTemp(Future);
         }
@@ -95,7 +840,11 @@ public:
         return AddQueuedWork<void>(Function, CompletionCallback);
     }
 
-    void AddQueuedEventChain(
+    // Returns false if no worker thread exists or if the batch is rejected.
+    // Futures of rejected tasks are resolved without executing the tasks,
+    // the completion callback is only called once all tasks have been queued
+    // and completed.
+    bool AddQueuedEventChain(
         const TArray<FGWTEventTask>& EventTasks,
         FGWTEventFuture* WaitList = nullptr,
         TFunction<void()> CompletionCallback = TFunction<void()>()
@@ -116,49 +865,120 @@ public:
                 CompletionCallback();
             }
 
-            return;
+            return true;
+        }
+
+        if (! bThreadPoolCreated)
+        {
+            return false;
         }
 
-        // Add tasks to thread pool
+        // Add tasks to thread pool as a single batch
 
-        // Add queued tasks with completion callback
+        TFunction<void()> Callback;
+        FGWTCompletionCounter* TaskCounter = nullptr;
+
+        // Add queued tasks with completion callback, abandoned tasks
+        // also resolve their promise so the counter always reaches zero.
+        // The extra count is held until the batch has been accepted.
         if (CompletionCallback)
         {
-            TSharedRef<FThreadSafeCounter> TaskCounter( new FThreadSafeCounter(EventTasks.Num()) );
-            TFunction<void()> Callback(
-                [TaskCounter, CompletionCallback]()
+            TaskCounter = FGWTCompletionCounter::Allocate(EventTasks.Num() + 1);
+            Callback = [TaskCounter, CompletionCallback]()
+            {
+                if (TaskCounter->Decrement())
                 {
-                    int32 CurrentTaskCount = TaskCounter->Decrement();
+                    CompletionCallback();
+                }
+            };
+        }
 
-                    if (CurrentTaskCount == 0)
-                    {
-                        CompletionCallback();
-                    }
-                } );
+        TArray<IQueuedWork*> QueuedWorkBatch;
+        QueuedWorkBatch.Reserve(EventTasks.Num());
 
-            for (const FGWTEventTask& EventTask : EventTasks)
-            {
-                EventTask.Key->Future = AddQueuedWork(EventTask.Value, Callback);
-            }
+        for (const FGWTEventTask& EventTask : EventTasks)
+        {
+            TFunction<void()> TaskFunction(EventTask.Value);
+            TFunction<void()> TaskCallback(Callback);
+
+            TPromise<void> Promise(MoveTemp(TaskCallback));
+            EventTask.Key->Future = Promise.GetFuture();
+
+            QueuedWorkBatch.Emplace(new TGWTAsyncQueuedWork<void>(MoveTemp(TaskFunction), MoveTemp(Promise)));
         }
-        else
+
+        const bool bIsQueued = AddQueuedWorkBatch(QueuedWorkBatch);
+
+        // Rejected batch, abandon tasks to resolve task futures
+        if (! bIsQueued)
         {
-            for (const FGWTEventTask& EventTask : EventTasks)
+            for (IQueuedWork* Work : QueuedWorkBatch)
             {
-                EventTask.Key->Future = AddQueuedWork(EventTask.Value);
+                Work->Abandon();
             }
         }
+
+        // Release the held count, tasks may have all completed already
+        if (TaskCounter && TaskCounter->Decrement() && bIsQueued)
+        {
+            CompletionCallback();
+        }
+
+        return bIsQueued;
     }
+
+private:
+
+    void CreateThreads(int32 InThreadCount);
+    void DestroyThreads();
+
+    bool DequeueWork(FQueuedEntry& OutEntry);
+
+    // Pushes entry to the queue, queue lock must be held
+    void PushEntry(const FQueuedEntry& Entry);
+
+    // Pops the oldest queued entry, queue lock must be held
+    IQueuedWork* PopOldestEntry();
+
+    // Moves delayed work due at the current time to the queue,
+    // returns the number of promoted work, queue lock must be held
+    int32 PromoteDelayedWork(double CurrentTime);
+
+    // Waits for free queue capacity, executing queued work
+    // if called from one of the pool worker threads
+    void WaitForQueueCapacity();
+
+    typedef TArray<FWorkerThread*, TInlineAllocator<16>> FWakeThreadList;
+
+    // Pops parked threads required to execute work count, queue lock must be held
+    void PopParkedThreads(int32 WorkCount, FWakeThreadList& OutWakeThreads);
+    static void WakeThreads(const FWakeThreadList& InWakeThreads);
+    void ExecuteWorkerThread(FWorkerThread& WorkerThread);
 };
 
 typedef TSharedPtr<struct FGWTAsyncTask> FPSGWTAsyncTask;
 
+// Task group task function, see GWTTaskGroup.h
+typedef TFunction<void(class FGWTTaskScope&)> FGWTTaskGroupFunction;
+
+// Launches task group root task on the thread pool, completion callback is
+// executed once the root task and all of its descendant tasks have completed
+GENERICWORKERTHREAD_API void GWTLaunchTaskGroup(
+    FGWTAsyncThreadPool& ThreadPool,
+    FGWTTaskGroupFunction RootFunction,
+    TFunction<void()> CompletionCallback,
+    const FPRGWTAsyncTaskState& TaskState
+    );
+
 struct GENERICWORKERTHREAD_API FGWTAsyncTask
 {
     FGWTAsyncThreadPool* ThreadPool = nullptr;
     FPSGWTEventFuture Future        = nullptr;
     FGWTEventTaskList TaskList;
 
+    // Task group root function, a task group stage has no task list
+    FGWTTaskGroupFunction GroupFunction;
+
     FGWTAsyncTask() = default;
 
     FGWTAsyncTask(const FPSGWTEventFuture& InFuture, FGWTAsyncThreadPool& InThreadPool)
@@ -171,6 +991,7 @@ struct GENERICWORKERTHREAD_API FGWTAsyncTask
     {
         Future.Reset();
         TaskList.Empty();
+        GroupFunction = nullptr;
         ThreadPool = nullptr;
     }
 
@@ -188,7 +1009,7 @@ struct GENERICWORKERTHREAD_API FGWTAsyncTask
     {
         if (IsValid())
         {
-            Future->Wait();
+            Future->Wait(ThreadPool);
             Future.Reset();
         }
     }
@@ -229,12 +1050,91 @@ struct GENERICWORKERTHREAD_API FGWTAsyncTask
     {
         if (ThreadPool != nullptr && Future.IsValid())
         {
-            ThreadPool->AddQueuedEventChain(TaskList, nullptr, CompletionCallback);
-            return true;
+            return ThreadPool->AddQueuedEventChain(TaskList, nullptr, CompletionCallback);
         }
 
         return false;
     }
+
+    // Record chain id is non-zero if task execution is being recorded
+    bool EnqueueTask(
+        const FPRGWTAsyncTaskState& TaskState,
+        TFunction<void()> CompletionCallback,
+        uint32 RecordChainId = 0,
+        int32 RecordStageIndex = 0
+        )
+    {
+        if (ThreadPool == nullptr || ! Future.IsValid())
+        {
+            return false;
+        }
+
+        // Task group stage, completion is deferred until the group root
+        // task and all of its descendant tasks have completed
+
+        if (GroupFunction)
+        {
+            typedef TSharedRef<double, ESPMode::ThreadSafe> FStartTimeRef;
+
+            FGWTTaskGroupFunction RootFunction(GroupFunction);
+            FStartTimeRef StartTime(MakeShared<double, ESPMode::ThreadSafe>(0.0));
+
+            // Record group as a single task from root start to group completion
+            if (RecordChainId != 0)
+            {
+                TFunction<void()> GroupCallback(MoveTemp(CompletionCallback));
+                CompletionCallback = [GroupCallback, StartTime, RecordChainId, RecordStageIndex]()
+                {
+                    FGWTTaskRecorder::RecordTask(RecordChainId, RecordStageIndex, 0, *StartTime, FPlatformTime::Seconds());
+
+                    if (GroupCallback)
+                    {
+                        GroupCallback();
+                    }
+                };
+            }
+
+            GWTLaunchTaskGroup(
+                *ThreadPool,
+                [TaskState, RootFunction, StartTime](FGWTTaskScope& Scope)
+                {
+                    TaskState->Transition(EGWTAsyncTaskState::Queued, EGWTAsyncTaskState::Running);
+                    *StartTime = FPlatformTime::Seconds();
+                    RootFunction(Scope);
+                },
+                MoveTemp(CompletionCallback),
+                TaskState
+                );
+
+            return true;
+        }
+
+        // Wrap task callbacks to update task state on execution
+        // and skip task execution once the task has been cancelled
+
+        FGWTEventTaskList StateTaskList;
+        StateTaskList.Reserve(TaskList.Num());
+
+        for (int32 TaskIndex=0; TaskIndex<TaskList.Num(); ++TaskIndex)
+        {
+            const FGWTEventTask& EventTask(TaskList[TaskIndex]);
+            TFunction<void()> TaskCallback(
+                FGWTTaskRecorder::WrapTask(EventTask.Value, RecordChainId, RecordStageIndex, TaskIndex));
+            StateTaskList.Emplace(
+                EventTask.Key,
+                [TaskState, TaskCallback]()
+                {
+                    TaskState->Transition(EGWTAsyncTaskState::Queued, EGWTAsyncTaskState::Running);
+
+                    if (TaskState->Get() != EGWTAsyncTaskState::Cancelled)
+                    {
+                        TaskCallback();
+                    }
+                } );
+        }
+
+        return ThreadPool->AddQueuedEventChain(StateTaskList, nullptr, CompletionCallback);
+    }
 };
 
 USTRUCT(BlueprintType)
@@ -242,6 +1142,8 @@ struct GENERICWORKERTHREAD_API FGWTAsyncTaskRef
 {
     GENERATED_BODY()
 
+    typedef TFunction<void(EGWTAsyncTaskState)> FTaskDoneCallback;
+
     FPSGWTAsyncThreadPool ThreadPool = nullptr;
     FPSGWTAsyncTask Task             = nullptr;
     TArray<FPSGWTAsyncTask> ChainedTasks;
@@ -303,7 +1205,8 @@ struct GENERICWORKERTHREAD_API FGWTAsyncTaskRef
 
         ChainedTasks.Empty();
 
-        TaskProgress = -1;
+        // Detach state from any task still in flight
+        State = MakeShared<FGWTAsyncTaskState, ESPMode::ThreadSafe>();
     }
 
     FORCEINLINE bool IsValid() const
@@ -311,32 +1214,104 @@ struct GENERICWORKERTHREAD_API FGWTAsyncTaskRef
         return Task.IsValid() && Task->IsValid();
     }
 
+    // Rebinds the idle task chain to the specified thread pool. Task objects
+    // shared with other task refs are cloned first, leaving other copies
+    // bound to their original thread pool.
+    bool SetThreadPool(const FPSGWTAsyncThreadPool& InThreadPool)
+    {
+        if (! InThreadPool.IsValid() || ! IsValid() || ! IsIdle())
+        {
+            return false;
+        }
+
+        bool bIsShared = Task.GetSharedReferenceCount() > 1;
+
+        for (const FPSGWTAsyncTask& ChainedTask : ChainedTasks)
+        {
+            bIsShared |= ChainedTask.GetSharedReferenceCount() > 1;
+        }
+
+        ThreadPool = InThreadPool;
+
+        if (bIsShared)
+        {
+            Task = CloneTask(Task, *ThreadPool);
+
+            for (FPSGWTAsyncTask& ChainedTask : ChainedTasks)
+            {
+                ChainedTask = CloneTask(ChainedTask, *ThreadPool);
+            }
+
+            // Cloned chain no longer tracks the state of other copies
+            State = MakeShared<FGWTAsyncTaskState, ESPMode::ThreadSafe>();
+        }
+        else
+        {
+            Task->ThreadPool = ThreadPool.Get();
+
+            for (FPSGWTAsyncTask& ChainedTask : ChainedTasks)
+            {
+                if (ChainedTask.IsValid() && ChainedTask->IsValid())
+                {
+                    ChainedTask->ThreadPool = ThreadPool.Get();
+                }
+            }
+        }
+
+        return true;
+    }
+
+    FORCEINLINE EGWTAsyncTaskState GetState() const
+    {
+        return State->Get();
+    }
+
     FORCEINLINE bool IsIdle() const
     {
-        return ! Task.IsValid() || TaskProgress == -1;
+        return ! Task.IsValid() || GetState() == EGWTAsyncTaskState::Idle;
     }
 
     FORCEINLINE bool IsExecuted() const
     {
-        return TaskProgress != -1;
+        return GetState() != EGWTAsyncTaskState::Idle;
     }
 
     FORCEINLINE bool IsDone() const
     {
-        return IsValid() && (TaskProgress == 0);
+        return IsValid() && GetState() == EGWTAsyncTaskState::Done;
     }
 
-    FORCEINLINE void Wait()
+    FORCEINLINE bool IsCancelled() const
     {
-        if (IsValid())
+        return GetState() == EGWTAsyncTaskState::Cancelled;
+    }
+
+    // Cancels queued or running task. Task callbacks that have not yet started
+    // are skipped and remaining chained tasks are not enqueued.
+    FORCEINLINE bool Cancel()
+    {
+        return State->Transition(EGWTAsyncTaskState::Queued, EGWTAsyncTaskState::Cancelled)
+            || State->Transition(EGWTAsyncTaskState::Running, EGWTAsyncTaskState::Cancelled);
+    }
+
+    void Wait()
+    {
+        if (! IsValid())
         {
-            Task->Wait();
+            return;
         }
+
+        // Chained tasks are enqueued progressively, wait for the whole
+        // chain to resolve while executing pending work of the task pool
+
+        State->Wait(Task->ThreadPool);
+
+        Task->Wait();
     }
 
     FORCEINLINE void AddTask(const TFunction<void()>& TaskCallback)
     {
-        if (IsValid() && IsIdle())
+        if (IsValid() && IsIdle() && ! Task->GroupFunction)
         {
             Task->AddTask(TaskCallback);
         }
@@ -370,7 +1345,7 @@ struct GENERICWORKERTHREAD_API FGWTAsyncTaskRef
         }
 
         // Task list is empty, add task to the list without creating new task object
-        if (Task->TaskList.Num() == 0)
+        if (Task->TaskList.Num() == 0 && ! Task->GroupFunction)
         {
             AddTask(TaskCallback);
         }
@@ -387,67 +1362,145 @@ struct GENERICWORKERTHREAD_API FGWTAsyncTaskRef
         }
     }
 
+    // Chains task group stage. The root function may spawn child tasks into
+    // the same thread pool, following chained tasks are only enqueued once
+    // the root task and all of its descendant tasks have completed.
+    void AddTaskGroupChain(const FGWTTaskGroupFunction& RootFunction)
+    {
+        if (! IsIdle() || ! IsValid() || ! RootFunction)
+        {
+            return;
+        }
+
+        // Current task is empty, use it as the group stage
+        if (Task->TaskList.Num() == 0 && ! Task->GroupFunction)
+        {
+            Task->GroupFunction = RootFunction;
+        }
+        // Create new task object for the group stage
+        else
+        {
+            ChainedTasks.Emplace(Task);
+
+            Task = MakeShareable(new FGWTAsyncTask(
+                MakeShareable(new FGWTEventFuture),
+                *ThreadPool
+                ) );
+            Task->GroupFunction = RootFunction;
+        }
+    }
+
     FORCEINLINE void Merge(FGWTAsyncTaskRef& OtherTaskRef, bool bResetOther = false)
     {
-        if (IsValid() && OtherTaskRef.IsValid() && IsIdle())
+        if (IsValid() && OtherTaskRef.IsValid() && IsIdle() && ! Task->GroupFunction)
         {
             Task->Merge(*OtherTaskRef.Task, bResetOther);
         }
     }
 
-    bool EnqueueTask()
+    // Enqueue task chain to the thread pool. The optional done callback is
+    // executed on the game thread through the tick manager once the task chain
+    // is either done or cancelled.
+    bool EnqueueTask(FTaskDoneCallback DoneCallback = FTaskDoneCallback())
     {
         // Task is invalid or is currently in progress, abort
-        if (! IsValid() || ! IsIdle())
+        if (! IsValid() || ! State->Transition(EGWTAsyncTaskState::Idle, EGWTAsyncTaskState::Queued))
         {
             return false;
         }
 
-        bool bResult = false;
+        FPRGWTAsyncTaskState TaskState(State);
 
-        if (ChainedTasks.Num() > 0)
-        {
-            TSharedPtr<TFunction<void()>> Callback0(nullptr);
-            TSharedPtr<TFunction<void()>> Callback1(nullptr);
+        // Registers chain graph if task execution is being recorded
+        const uint32 RecordChainId = FGWTTaskRecorder::IsRecording()
+            ? FGWTTaskRecorder::BeginChain(ChainedTasks.Num()+1)
+            : 0;
 
+        // Final completion callback, resolves task state
+        TFunction<void()> Callback(
+            [TaskState, DoneCallback]()
             {
-                FPSGWTAsyncTask& ChainedTask(Task);
-                Callback1 = MakeShareable(new TFunction<void()>(
-                    [ChainedTask, this]()
-                    {
-                        check(ChainedTask.IsValid());
-                        ChainedTask->EnqueueTask([this](){ TaskProgress = 0; });
-                    } ) );
-            }
+                GWT_TRACE_EVENT("GWT.TaskChain.Done");
+
+                TaskState->Transition(EGWTAsyncTaskState::Running, EGWTAsyncTaskState::Done);
+                TaskState->Transition(EGWTAsyncTaskState::Queued, EGWTAsyncTaskState::Done);
+
+                if (DoneCallback)
+                {
+                    FGWTAsyncTaskRef::EnqueueDoneCallback(DoneCallback, TaskState->Get());
+                }
+            } );
+
+        // Chain task callbacks from the last task towards the first task,
+        // cancelled task skip enqueue of the remaining chained tasks
+
+        FPSGWTAsyncTask NextTask(Task);
+
+        for (int32 i=(ChainedTasks.Num()-1); i>=0; --i)
+        {
+            // Stage index of the next task, chained tasks precede current task
+            const int32 NextStageIndex = i+1;
 
-            for (int32 i=(ChainedTasks.Num()-1); i>=1; --i)
+            TFunction<void()> NextCallback(MoveTemp(Callback));
+            Callback = [NextTask, TaskState, NextCallback, RecordChainId, NextStageIndex]()
             {
-                FPSGWTAsyncTask& ChainedTask(ChainedTasks[i]);
-                Callback0 = Callback1;
-                Callback1 = MakeShareable(new TFunction<void()>(
-                    [Callback0, ChainedTask]()
-                    {
-                        check(ChainedTask.IsValid());
-                        ChainedTask->EnqueueTask(*Callback0);
-                    } ) );
-            }
+                check(NextTask.IsValid());
 
-            check(ChainedTasks[0].IsValid());
+                GWT_TRACE_EVENT("GWT.TaskChain.Stage");
 
-            TaskProgress = 1;
-            bResult = ChainedTasks[0]->EnqueueTask(*Callback1);
+                if (TaskState->Get() == EGWTAsyncTaskState::Cancelled)
+                {
+                    NextCallback();
+                }
+                // Rejected stage cancels the remaining chain
+                else if (! NextTask->EnqueueTask(TaskState, NextCallback, RecordChainId, NextStageIndex))
+                {
+                    TaskState->Transition(EGWTAsyncTaskState::Running, EGWTAsyncTaskState::Cancelled);
+                    TaskState->Transition(EGWTAsyncTaskState::Queued, EGWTAsyncTaskState::Cancelled);
+                    NextCallback();
+                }
+            };
+            NextTask = ChainedTasks[i];
         }
-        else
+
+        check(NextTask.IsValid());
+
+        if (! NextTask->EnqueueTask(TaskState, Callback, RecordChainId, 0))
         {
-            TaskProgress = 1;
-            bResult = Task->EnqueueTask([this](){ TaskProgress = 0; });
+            TaskState->Set(EGWTAsyncTaskState::Idle);
+            return false;
         }
 
-        return bResult;
+        return true;
     }
 
 private:
-    int32 TaskProgress = -1;
+
+    FPRGWTAsyncTaskState State = MakeShared<FGWTAsyncTaskState, ESPMode::ThreadSafe>();
+
+    static void EnqueueDoneCallback(const FTaskDoneCallback& DoneCallback, EGWTAsyncTaskState TaskState);
+
+    static FPSGWTAsyncTask CloneTask(const FPSGWTAsyncTask& SourceTask, FGWTAsyncThreadPool& InThreadPool)
+    {
+        if (! SourceTask.IsValid() || ! SourceTask->IsValid())
+        {
+            return SourceTask;
+        }
+
+        FPSGWTAsyncTask ClonedTask(MakeShareable(new FGWTAsyncTask(
+            MakeShareable(new FGWTEventFuture),
+            InThreadPool
+            ) ) );
+
+        for (const FGWTEventTask& EventTask : SourceTask->TaskList)
+        {
+            ClonedTask->AddTask(EventTask.Value);
+        }
+
+        ClonedTask->GroupFunction = SourceTask->GroupFunction;
+
+        return ClonedTask;
+    }
 };
 
 UCLASS(BlueprintType)
@@ -463,6 +1516,9 @@ public:
 	UPROPERTY(BlueprintAssignable)
     FGWTAsyncTaskObject_OnTaskDone OnTaskDone;
 
+	UPROPERTY(BlueprintAssignable)
+    FGWTAsyncTaskObject_OnTaskCancelled OnTaskCancelled;
+
     UFUNCTION(BlueprintCallable)
     void ResetTask()
     {
@@ -494,6 +1550,19 @@ public:
     }
 
     UFUNCTION(BlueprintCallable)
+    EGWTAsyncTaskState GetTaskState() const
+    {
+        return TaskRef.GetState();
+    }
+
+    UFUNCTION(BlueprintCallable)
+    bool CancelTask()
+    {
+        return TaskRef.Cancel();
+    }
+
+    // Blocks the calling thread, use the Execute Async Task node instead
+    UFUNCTION(BlueprintCallable, meta=(DeprecatedFunction, DeprecationMessage="WaitTask blocks the game thread, use Execute Async Task instead"))
     void WaitTask()
     {
         TaskRef.Wait();
@@ -505,9 +1574,37 @@ public:
         TaskRef.AddTaskChain(OtherTaskRef, bResetOther);
     }
 
+    // Enqueue task, OnTaskDone or OnTaskCancelled is broadcasted
+    // on the game thread once the task has completed
     UFUNCTION(BlueprintCallable)
-    bool ExecuteTask()
+    bool ExecuteTask();
+
+    // Resets object for reuse, returns false if the task is still in flight.
+    // Done callbacks of executions before the reset are ignored.
+    bool ResetPooledObject()
     {
-        return TaskRef.EnqueueTask();
+        const EGWTAsyncTaskState TaskState = TaskRef.GetState();
+
+        if (TaskState == EGWTAsyncTaskState::Queued || TaskState == EGWTAsyncTaskState::Running)
+        {
+            return false;
+        }
+
+        ++PoolGeneration;
+
+        TaskRef.Reset();
+        TaskRef.ThreadPool.Reset();
+        TaskRef.Task.Reset();
+        OnTaskDone.Clear();
+        OnTaskCancelled.Clear();
+        return true;
     }
+
+private:
+
+    // Incremented on each pooled reset, done callbacks queued on the tick
+    // manager only broadcast if the object has not been reset since
+    int32 PoolGeneration = 0;
+
+    void BroadcastTaskState(EGWTAsyncTaskState TaskState);
 };
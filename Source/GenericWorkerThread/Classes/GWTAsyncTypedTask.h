@@ -0,0 +1,490 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/IQueuedWork.h"
+#include "Misc/Optional.h"
+#include "Templates/UniquePtr.h"
+#include "GenericWorkerThread.h"
+#include "GWTAsyncThreadPool.h"
+
+// Typed Task Chain
+//
+// Chain of typed task stages where each stage result is moved directly into
+// the input storage of the next stage. Stage nodes are allocated once when
+// the chain is declared and act as the thread pool work themselves, so
+// executing a chain does not allocate per stage or per result, except for
+// the promise of the final result. A declared chain can be enqueued again
+// once the previous execution has completed.
+//
+// A stage rejected or dropped by the thread pool abandons the chain,
+// resolving the final result with a default value without executing
+// the remaining stages.
+
+class FGWTTypedTaskNodeBase : public IQueuedWork
+{
+public:
+
+    class FGWTTypedTaskChain* Chain = nullptr;
+
+    virtual ~FGWTTypedTaskNodeBase() = default;
+
+    virtual void Execute() = 0;
+
+    // -- BEGIN IQueuedWork
+
+    virtual void DoThreadedWork() override
+    {
+        Execute();
+    }
+
+    virtual void Abandon() override;
+
+    // -- END IQueuedWork
+};
+
+class FGWTTypedTaskChain
+{
+public:
+
+    FGWTAsyncThreadPool& ThreadPool;
+    FGWTTypedTaskNodeBase* RootNode = nullptr;
+    TArray<TUniquePtr<FGWTTypedTaskNodeBase>> Nodes;
+
+    // Keeps chain alive while executing, released on completion
+    TSharedPtr<FGWTTypedTaskChain, ESPMode::ThreadSafe> SelfReference;
+    volatile int32 bIsRunning = 0;
+
+    // Resolves the final result of the current execution with a default value
+    TFunction<void()> AbandonCallback;
+
+    FGWTTypedTaskChain(FGWTAsyncThreadPool& InThreadPool)
+        : ThreadPool(InThreadPool)
+    {
+    }
+
+    template<typename NodeType>
+    NodeType* AddNode(NodeType* Node)
+    {
+        Nodes.Emplace(Node);
+        Node->Chain = this;
+
+        if (! RootNode)
+        {
+            RootNode = Node;
+        }
+
+        return Node;
+    }
+
+    FORCEINLINE void Enqueue(FGWTTypedTaskNodeBase* Node)
+    {
+        // Rejected work is left untouched by the thread pool
+        if (! ThreadPool.AddQueuedWork(Node))
+        {
+            Node->Abandon();
+        }
+    }
+
+    // At most one stage of an execution is abandoned,
+    // the chain may be destroyed once this call returns
+    FORCEINLINE void Abandon()
+    {
+        check(AbandonCallback);
+        AbandonCallback();
+    }
+};
+
+FORCEINLINE void FGWTTypedTaskNodeBase::Abandon()
+{
+    check(Chain);
+    Chain->Abandon();
+}
+
+template<typename ResultType>
+class TGWTTypedTaskNode : public FGWTTypedTaskNodeBase
+{
+public:
+
+    // Receives node result, assigned when the next stage is declared
+    // or when the chain is enqueued on the last stage
+    TFunction<void(ResultType&&)> Continuation;
+    bool bHasNextStage = false;
+
+protected:
+
+    FORCEINLINE void Complete(ResultType&& Result)
+    {
+        check(Continuation);
+
+        // Chain result continuation is cleared before it is executed,
+        // the chain may be enqueued again or destroyed once it resolves
+        if (! bHasNextStage)
+        {
+            TFunction<void(ResultType&&)> ResultContinuation(MoveTemp(Continuation));
+            Continuation = nullptr;
+            ResultContinuation(MoveTemp(Result));
+            return;
+        }
+
+        Continuation(MoveTemp(Result));
+    }
+};
+
+template<typename ResultType>
+class TGWTTypedLaunchNode : public TGWTTypedTaskNode<ResultType>
+{
+public:
+
+    TFunction<ResultType()> Function;
+
+    virtual void Execute() override
+    {
+        this->Complete(Function());
+    }
+};
+
+template<typename InputType, typename ResultType>
+class TGWTTypedThenNode : public TGWTTypedTaskNode<ResultType>
+{
+public:
+
+    TOptional<InputType> Input;
+    TFunction<ResultType(InputType&&)> Function;
+
+    virtual void Execute() override
+    {
+        check(Input.IsSet());
+        ResultType Result(Function(MoveTemp(Input.GetValue())));
+        Input.Reset();
+        this->Complete(MoveTemp(Result));
+    }
+};
+
+struct FGWTTypedTaskNoInput
+{
+};
+
+// Fan-out to parallel sub-tasks, gathering sub-task results into
+// an array preallocated to the sub-task count before execution
+template<typename InputType, typename ElementType>
+class TGWTTypedGatherNode : public TGWTTypedTaskNode<TArray<ElementType>>
+{
+    struct FSubTaskWork : public IQueuedWork
+    {
+        TGWTTypedGatherNode* Node;
+        int32 Index;
+
+        virtual void DoThreadedWork() override
+        {
+            Node->ExecuteSubTask(Index);
+        }
+
+        virtual void Abandon() override
+        {
+            Node->AbandonSubTask();
+        }
+    };
+
+    FGWTAsyncThreadPool& ThreadPool;
+    TArray<FSubTaskWork> SubTaskWorks;
+    TArray<ElementType> Results;
+    FThreadSafeCounter RemainingCount;
+    volatile int32 bSubTaskAbandoned = 0;
+
+public:
+
+    TOptional<InputType> Input;
+    TFunction<ElementType(const InputType&, int32)> SubTask;
+    bool bPersistentInput = false;
+
+    TGWTTypedGatherNode(FGWTAsyncThreadPool& InThreadPool, int32 InSubTaskCount)
+        : ThreadPool(InThreadPool)
+    {
+        SubTaskWorks.SetNum(FMath::Max(InSubTaskCount, 0));
+
+        for (int32 i=0; i<SubTaskWorks.Num(); ++i)
+        {
+            SubTaskWorks[i].Node = this;
+            SubTaskWorks[i].Index = i;
+        }
+    }
+
+    virtual void Execute() override
+    {
+        check(Input.IsSet());
+
+        const int32 SubTaskCount = SubTaskWorks.Num();
+
+        Results.Reset(SubTaskCount);
+        Results.SetNum(SubTaskCount);
+
+        if (SubTaskCount == 0)
+        {
+            CompleteGather();
+            return;
+        }
+
+        RemainingCount.Set(SubTaskCount);
+        FPlatformAtomics::InterlockedExchange(&bSubTaskAbandoned, 0);
+
+        TArray<IQueuedWork*> WorkBatch;
+        WorkBatch.Reserve(SubTaskCount);
+
+        for (FSubTaskWork& SubTaskWork : SubTaskWorks)
+        {
+            WorkBatch.Emplace(&SubTaskWork);
+        }
+
+        // Rejected batch is left untouched, none of the sub-tasks execute
+        if (! ThreadPool.AddQueuedWorkBatch(WorkBatch))
+        {
+            ReleaseInput();
+            this->Abandon();
+        }
+    }
+
+private:
+
+    void ExecuteSubTask(int32 Index)
+    {
+        Results[Index] = SubTask(Input.GetValue(), Index);
+        FinishSubTask();
+    }
+
+    void AbandonSubTask()
+    {
+        FPlatformAtomics::InterlockedExchange(&bSubTaskAbandoned, 1);
+        FinishSubTask();
+    }
+
+    // The last finished sub-task completes the gather,
+    // or abandons the chain if any sub-task has been dropped
+    void FinishSubTask()
+    {
+        if (RemainingCount.Decrement() != 0)
+        {
+            return;
+        }
+
+        if (FPlatformAtomics::AtomicRead(&bSubTaskAbandoned) != 0)
+        {
+            ReleaseInput();
+            this->Abandon();
+        }
+        else
+        {
+            CompleteGather();
+        }
+    }
+
+    void CompleteGather()
+    {
+        ReleaseInput();
+        this->Complete(MoveTemp(Results));
+    }
+
+    FORCEINLINE void ReleaseInput()
+    {
+        if (! bPersistentInput)
+        {
+            Input.Reset();
+        }
+    }
+};
+
+template<typename ResultType>
+class TGWTTypedTask
+{
+    template<typename> friend class TGWTTypedTask;
+
+    typedef TSharedPtr<FGWTTypedTaskChain, ESPMode::ThreadSafe> FPSChain;
+
+    FPSChain Chain;
+    TGWTTypedTaskNode<ResultType>* Tail = nullptr;
+
+    TGWTTypedTask(const FPSChain& InChain, TGWTTypedTaskNode<ResultType>* InTail)
+        : Chain(InChain)
+        , Tail(InTail)
+    {
+    }
+
+    template<typename NodeType>
+    static void LinkNode(FGWTTypedTaskChain& InChain, TGWTTypedTaskNode<ResultType>& From, NodeType* To)
+    {
+        check(! From.bHasNextStage);
+
+        From.bHasNextStage = true;
+
+        FGWTTypedTaskChain* ChainPtr = &InChain;
+        From.Continuation = [ChainPtr, To](ResultType&& Result)
+        {
+            To->Input.Emplace(MoveTemp(Result));
+            ChainPtr->Enqueue(To);
+        };
+    }
+
+public:
+
+    TGWTTypedTask() = default;
+
+    static TGWTTypedTask Create(FGWTAsyncThreadPool& ThreadPool, TFunction<ResultType()> Function)
+    {
+        check(Function);
+
+        FPSChain NewChain(MakeShared<FGWTTypedTaskChain, ESPMode::ThreadSafe>(ThreadPool));
+
+        TGWTTypedLaunchNode<ResultType>* Node = NewChain->AddNode(new TGWTTypedLaunchNode<ResultType>);
+        Node->Function = MoveTemp(Function);
+
+        return TGWTTypedTask(NewChain, Node);
+    }
+
+    template<typename ElementType>
+    static TGWTTypedTask<TArray<ElementType>> CreateGather(FGWTAsyncThreadPool& ThreadPool, TArray<TFunction<ElementType()>> SubTasks)
+    {
+        typedef TGWTTypedGatherNode<FGWTTypedTaskNoInput, ElementType> FGatherNode;
+
+        typename TGWTTypedTask<TArray<ElementType>>::FPSChain NewChain(
+            MakeShared<FGWTTypedTaskChain, ESPMode::ThreadSafe>(ThreadPool) );
+
+        FGatherNode* Node = NewChain->AddNode(new FGatherNode(ThreadPool, SubTasks.Num()));
+        Node->Input.Emplace();
+        Node->bPersistentInput = true;
+        Node->SubTask = [SubTasks](const FGWTTypedTaskNoInput&, int32 Index)
+        {
+            return SubTasks[Index]();
+        };
+
+        return TGWTTypedTask<TArray<ElementType>>(NewChain, Node);
+    }
+
+    FORCEINLINE bool IsValid() const
+    {
+        return Chain.IsValid() && Tail != nullptr;
+    }
+
+    FORCEINLINE bool IsRunning() const
+    {
+        return IsValid() && FPlatformAtomics::AtomicRead(&Chain->bIsRunning) != 0;
+    }
+
+    // Declares the next stage, the stage receives this stage result by move.
+    // Each stage can only be followed by a single next stage.
+    template<typename NextType>
+    TGWTTypedTask<NextType> Then(TFunction<NextType(ResultType&&)> Function)
+    {
+        check(IsValid() && ! IsRunning());
+        check(Function);
+
+        typedef TGWTTypedThenNode<ResultType, NextType> FThenNode;
+
+        FThenNode* Node = Chain->AddNode(new FThenNode);
+        Node->Function = MoveTemp(Function);
+
+        LinkNode(*Chain, *Tail, Node);
+
+        return TGWTTypedTask<NextType>(Chain, Node);
+    }
+
+    // Declares a fan-out stage of parallel sub-tasks, each reading this stage
+    // result, whose results are gathered in sub-task index order
+    template<typename ElementType>
+    TGWTTypedTask<TArray<ElementType>> ThenGather(int32 SubTaskCount, TFunction<ElementType(const ResultType&, int32)> SubTask)
+    {
+        check(IsValid() && ! IsRunning());
+        check(SubTask);
+
+        typedef TGWTTypedGatherNode<ResultType, ElementType> FGatherNode;
+
+        FGatherNode* Node = Chain->AddNode(new FGatherNode(Chain->ThreadPool, SubTaskCount));
+        Node->SubTask = MoveTemp(SubTask);
+
+        LinkNode(*Chain, *Tail, Node);
+
+        return TGWTTypedTask<TArray<ElementType>>(Chain, Node);
+    }
+
+    // Enqueues the whole chain, must be called on the last declared stage.
+    // Returns invalid future if the stage has a next stage or if the chain is
+    // still executing. The future resolves to a default result if any stage
+    // is rejected or abandoned.
+    TFuture<ResultType> Enqueue()
+    {
+        check(IsValid());
+
+        if (Tail->bHasNextStage)
+        {
+            UE_LOG(LogGWT, Warning, TEXT("TGWTTypedTask::Enqueue() - Enqueue called on an intermediate stage, chain not enqueued"));
+            return TFuture<ResultType>();
+        }
+
+        if (FPlatformAtomics::InterlockedCompareExchange(&Chain->bIsRunning, 1, 0) != 0)
+        {
+            return TFuture<ResultType>();
+        }
+
+        TSharedRef<TPromise<ResultType>, ESPMode::ThreadSafe> Promise(MakeShared<TPromise<ResultType>, ESPMode::ThreadSafe>());
+        TFuture<ResultType> Future(Promise->GetFuture());
+
+        FGWTTypedTaskChain* ChainPtr = Chain.Get();
+        Tail->Continuation = [ChainPtr, Promise](ResultType&& Result)
+        {
+            // Only locals are accessed once the chain is released from
+            // running state, the chain may be destroyed when this scope ends
+            FPSChain KeepAlive(MoveTemp(ChainPtr->SelfReference));
+            TSharedRef<TPromise<ResultType>, ESPMode::ThreadSafe> ResultPromise(Promise);
+            ResultType FinalResult(MoveTemp(Result));
+
+            // Chain can be enqueued again as soon as the result is visible
+            FPlatformAtomics::InterlockedExchange(&KeepAlive->bIsRunning, 0);
+            ResultPromise->SetValue(MoveTemp(FinalResult));
+        };
+
+        Chain->AbandonCallback = [ChainPtr, Promise]()
+        {
+            FPSChain KeepAlive(MoveTemp(ChainPtr->SelfReference));
+            TSharedRef<TPromise<ResultType>, ESPMode::ThreadSafe> ResultPromise(Promise);
+
+            FPlatformAtomics::InterlockedExchange(&KeepAlive->bIsRunning, 0);
+            GWTAbandonPromise(*ResultPromise);
+        };
+
+        Chain->SelfReference = Chain;
+        Chain->Enqueue(Chain->RootNode);
+
+        return Future;
+    }
+};
+
+template<typename ElementType>
+FORCEINLINE TGWTTypedTask<TArray<ElementType>> GWTCreateGatherTask(FGWTAsyncThreadPool& ThreadPool, TArray<TFunction<ElementType()>> SubTasks)
+{
+    return TGWTTypedTask<TArray<ElementType>>::template CreateGather<ElementType>(ThreadPool, MoveTemp(SubTasks));
+}
@@ -36,6 +36,72 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FGWTPromiseObject_OnPromiseDone);
 template<typename ResultType>
 using TGWTAsyncFuture  = TFuture<ResultType>;
 
+// Submission behaviour once a bounded queue reaches its capacity
+enum class EGWTQueueOverflowPolicy : uint8
+{
+    // Block submitting thread until the queue has free capacity
+    Block,
+
+    // Reject submission, submit call returns false
+    Reject,
+
+    // Discard the oldest queued entry to make room for the new entry
+    DropOldest,
+
+    // Execute the new entry on the submitting thread
+    RunInline
+};
+
+// Executes pending work on behalf of a thread that waits for completion,
+// turning blocked threads into throughput and allowing a pool worker thread
+// to wait on work queued to its own pool without deadlocking the pool.
+class GENERICWORKERTHREAD_API IGWTWaitHelper
+{
+public:
+
+    virtual ~IGWTWaitHelper() = default;
+
+    // Executes a single pending work, returns false if there is none
+    virtual bool TryExecuteQueuedWork() = 0;
+
+    // Wait helper associated with the calling thread, if any.
+    // Thread pool worker threads are associated with their owning pool.
+    static IGWTWaitHelper* GetCurrent();
+    static void SetCurrent(IGWTWaitHelper* WaitHelper);
+};
+
+// Waits for the future to be ready, executing pending work from the wait
+// helper in the meantime. Uses the calling thread wait helper if none is
+// specified, blocks if the calling thread has no wait helper.
+template<typename ResultType>
+void GWTWaitForFuture(const TFuture<ResultType>& Future, IGWTWaitHelper* WaitHelper = nullptr)
+{
+    if (! Future.IsValid())
+    {
+        return;
+    }
+
+    if (! WaitHelper)
+    {
+        WaitHelper = IGWTWaitHelper::GetCurrent();
+    }
+
+    if (! WaitHelper)
+    {
+        Future.Wait();
+        return;
+    }
+
+    while (! Future.IsReady())
+    {
+        // No pending work, wait briefly for either completion or new work
+        if (! WaitHelper->TryExecuteQueuedWork())
+        {
+            Future.WaitFor(FTimespan::FromMicroseconds(200));
+        }
+    }
+}
+
 template<typename ResultType>
 struct TGWTAsyncFutureContainer
 {
@@ -126,16 +192,16 @@ struct TGWTAsyncFutureList
         return Next;
     }
 
-    void Wait()
+    void Wait(IGWTWaitHelper* WaitHelper = nullptr)
     {
         if (Future.IsValid() && ! Future.IsReady())
         {
-            Future.Get();
+            GWTWaitForFuture(Future, WaitHelper);
         }
 
         if (Next)
         {
-            Next->Wait();
+            Next->Wait(WaitHelper);
         }
     }
 };
@@ -185,6 +251,71 @@ struct GENERICWORKERTHREAD_API FGWTTaskEventRef
     }
 };
 
+// Lightweight non-UObject promise handle, copies share the same promise
+struct GENERICWORKERTHREAD_API FGWTPromiseRef
+{
+    typedef TFunction<void()>                             FFutureCallback;
+    typedef TPromise<void>                                FPromise;
+    typedef TSharedPtr<FPromise, ESPMode::ThreadSafe>     FPSPromise;
+
+    FPSPromise Promise;
+    TSharedFuture<void> Future;
+
+    FGWTPromiseRef() = default;
+
+    // Creates new promise, completion callback is executed on the thread
+    // that fulfills the promise
+    static FGWTPromiseRef Create(FFutureCallback CompletionCallback = FFutureCallback())
+    {
+        FGWTPromiseRef PromiseRef;
+
+        PromiseRef.Promise = CompletionCallback
+            ? MakeShared<FPromise, ESPMode::ThreadSafe>(MoveTemp(CompletionCallback))
+            : MakeShared<FPromise, ESPMode::ThreadSafe>();
+
+        PromiseRef.Future = PromiseRef.Promise->GetFuture().Share();
+
+        return PromiseRef;
+    }
+
+    FORCEINLINE void Reset()
+    {
+        Promise.Reset();
+        Future = TSharedFuture<void>();
+    }
+
+    FORCEINLINE bool IsValid() const
+    {
+        return Future.IsValid();
+    }
+
+    FORCEINLINE bool IsReady() const
+    {
+        return Future.IsReady();
+    }
+
+    FORCEINLINE bool IsIdle() const
+    {
+        return ! IsValid() || IsReady();
+    }
+
+    FORCEINLINE void SetPromise()
+    {
+        check(Promise.IsValid());
+        check(! Future.IsReady());
+
+        Promise->SetValue();
+    }
+
+    FORCEINLINE void Wait() const
+    {
+        if (IsValid())
+        {
+            Future.Wait();
+        }
+    }
+};
+
 UCLASS(BlueprintType)
 class GENERICWORKERTHREAD_API UGWTTaskEventObject : public UObject
 {
@@ -207,7 +338,7 @@ public:
         return EventRef.IsValid();
     }
 
-    UFUNCTION(BlueprintCallable)
+    UFUNCTION(BlueprintCallable, meta=(DeprecatedFunction, DeprecationMessage="WaitEvent blocks the game thread, poll IsEventDone instead"))
     void WaitEvent()
     {
         EventRef.Wait();
@@ -218,6 +349,18 @@ public:
     {
         return EventRef.IsDone();
     }
+
+    // Resets object for reuse, returns false if the event is still pending
+    bool ResetPooledObject()
+    {
+        if (! EventRef.IsDone())
+        {
+            return false;
+        }
+
+        EventRef.Reset();
+        return true;
+    }
 };
 
 UCLASS(BlueprintType)
@@ -247,18 +390,21 @@ public:
         return Future.IsReady();
     }
 
-    UFUNCTION(BlueprintCallable)
+    UFUNCTION(BlueprintCallable, meta=(DeprecatedFunction, DeprecationMessage="Wait blocks the game thread, bind OnPromiseDone instead"))
     void Wait()
     {
         if (IsFutureValid() && ! IsFutureReady())
         {
-            Future.Wait();
+            GWTWaitForFuture(Future);
         }
     }
 
+    // Future becomes ready before its completion callback returns, idle
+    // additionally requires the completion callback to have finished
     FORCEINLINE bool IsIdle() const
     {
-        return !Future.IsValid() || Future.IsReady();
+        return !Future.IsValid()
+            || (Future.IsReady() && FPlatformAtomics::AtomicRead(&bCompletionPending) == 0);
     }
 
     FPSPromise InitPromise(FFutureCallback CompletionCallback = FFutureCallback())
@@ -267,12 +413,17 @@ public:
 
         FutureCallback = MoveTemp(CompletionCallback);
 
+        FPlatformAtomics::InterlockedExchange(&bCompletionPending, 1);
+
         Promise = MakeShareable(
             new FPromise(
                 [&]()
                 {
                     ExecuteFutureCallback();
                     ResetPromise();
+
+                    // Must remain the last access, object may be reused after
+                    FPlatformAtomics::InterlockedExchange(&bCompletionPending, 0);
                 } ) );
 
         Future = Promise->GetFuture();
@@ -293,11 +444,27 @@ public:
         return Promise;
     }
 
+    // Resets object for reuse, returns false if the promise is still pending
+    bool ResetPooledObject()
+    {
+        if (! IsIdle())
+        {
+            return false;
+        }
+
+        OnPromiseDone.Clear();
+        FutureCallback = FFutureCallback();
+        Future = FFuture();
+        Promise.Reset();
+        return true;
+    }
+
 private:
 
 	FPSPromise Promise;
     FFuture Future;
     FFutureCallback FutureCallback;
+    volatile int32 bCompletionPending = 0;
 
     void ResetPromise()
     {
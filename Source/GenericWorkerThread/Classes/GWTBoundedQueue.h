@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformAtomics.h"
+
+// Bounded multi-producer multi-consumer lock-free queue.
+//
+// Each cell carries a sequence number that tells producers and consumers
+// whether the cell is ready to be written or read, so both sides only
+// contend on their own position counter. Capacity is rounded up to the next
+// power of two and never grows, enqueue fails once the queue is full.
+template<typename ElementType>
+class TGWTBoundedQueue
+{
+    struct FCell
+    {
+        volatile int32 Sequence;
+        ElementType Data;
+    };
+
+    TArray<FCell> Cells;
+    int32 Mask;
+
+    volatile int32 EnqueuePos;
+    volatile int32 DequeuePos;
+
+    FORCEINLINE static int32 Offset(int32 Pos, int32 Count)
+    {
+        return static_cast<int32>(static_cast<uint32>(Pos) + static_cast<uint32>(Count));
+    }
+
+    FORCEINLINE static int32 Distance(int32 A, int32 B)
+    {
+        return static_cast<int32>(static_cast<uint32>(A) - static_cast<uint32>(B));
+    }
+
+    template<typename ArgType>
+    bool EnqueueImpl(ArgType&& Item)
+    {
+        FCell* Cell;
+        int32 Pos = FPlatformAtomics::AtomicRead(&EnqueuePos);
+
+        for (;;)
+        {
+            Cell = &Cells[Pos & Mask];
+
+            const int32 Sequence = FPlatformAtomics::AtomicRead(&Cell->Sequence);
+            const int32 Diff = Distance(Sequence, Pos);
+
+            if (Diff == 0)
+            {
+                if (FPlatformAtomics::InterlockedCompareExchange(&EnqueuePos, Offset(Pos, 1), Pos) == Pos)
+                {
+                    break;
+                }
+            }
+            // Queue is full
+            else if (Diff < 0)
+            {
+                return false;
+            }
+
+            Pos = FPlatformAtomics::AtomicRead(&EnqueuePos);
+        }
+
+        Cell->Data = Forward<ArgType>(Item);
+        FPlatformAtomics::InterlockedExchange(&Cell->Sequence, Offset(Pos, 1));
+
+        return true;
+    }
+
+public:
+
+    explicit TGWTBoundedQueue(int32 InCapacity)
+        : EnqueuePos(0)
+        , DequeuePos(0)
+    {
+        const int32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max(InCapacity, 2));
+
+        Cells.SetNum(Capacity);
+        Mask = Capacity - 1;
+
+        for (int32 i=0; i<Capacity; ++i)
+        {
+            Cells[i].Sequence = i;
+        }
+    }
+
+    TGWTBoundedQueue(const TGWTBoundedQueue&) = delete;
+    TGWTBoundedQueue& operator=(const TGWTBoundedQueue&) = delete;
+
+    FORCEINLINE int32 GetCapacity() const
+    {
+        return Mask + 1;
+    }
+
+    // Approximate number of queued elements, exact only when quiescent
+    FORCEINLINE int32 Num() const
+    {
+        const int32 Count = Distance(
+            FPlatformAtomics::AtomicRead(&EnqueuePos),
+            FPlatformAtomics::AtomicRead(&DequeuePos)
+            );
+        return FMath::Clamp(Count, 0, GetCapacity());
+    }
+
+    FORCEINLINE bool IsEmpty() const
+    {
+        return Num() == 0;
+    }
+
+    FORCEINLINE bool Enqueue(const ElementType& Item)
+    {
+        return EnqueueImpl(Item);
+    }
+
+    FORCEINLINE bool Enqueue(ElementType&& Item)
+    {
+        return EnqueueImpl(MoveTemp(Item));
+    }
+
+    bool Dequeue(ElementType& OutItem)
+    {
+        FCell* Cell;
+        int32 Pos = FPlatformAtomics::AtomicRead(&DequeuePos);
+
+        for (;;)
+        {
+            Cell = &Cells[Pos & Mask];
+
+            const int32 Sequence = FPlatformAtomics::AtomicRead(&Cell->Sequence);
+            const int32 Diff = Distance(Sequence, Offset(Pos, 1));
+
+            if (Diff == 0)
+            {
+                if (FPlatformAtomics::InterlockedCompareExchange(&DequeuePos, Offset(Pos, 1), Pos) == Pos)
+                {
+                    break;
+                }
+            }
+            // Queue is empty
+            else if (Diff < 0)
+            {
+                return false;
+            }
+
+            Pos = FPlatformAtomics::AtomicRead(&DequeuePos);
+        }
+
+        OutItem = MoveTemp(Cell->Data);
+        FPlatformAtomics::InterlockedExchange(&Cell->Sequence, Offset(Pos, Mask + 1));
+
+        return true;
+    }
+};
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformAtomics.h"
+
+// Cache line separation of concurrently written state. Fields written by
+// different threads are separated by a full cache line of padding to avoid
+// false sharing. Padding is used instead of over-alignment, heap allocations
+// only honor alignment beyond the default with C++17 aligned new.
+#define GWT_CACHE_LINE_SIZE PLATFORM_CACHE_LINE_SIZE
+#define GWT_CACHE_PAD uint8 PREPROCESSOR_JOIN(_CachePadding, __LINE__)[GWT_CACHE_LINE_SIZE]
+
+// Value followed by a full cache line of padding, adjacent padded values
+// never share a cache line regardless of their address
+template<typename ValueType>
+struct TGWTCacheLinePadded
+{
+    ValueType Value;
+    GWT_CACHE_PAD;
+
+    TGWTCacheLinePadded() = default;
+
+    TGWTCacheLinePadded(const ValueType& InValue)
+        : Value(InValue)
+    {
+    }
+};
+
+// Completion counter occupying its own cache line, allocated from pooled
+// cache line aligned slabs instead of the general purpose allocator.
+// Counters are padded to the cache line size, the slab alignment places
+// each counter on its own line. Released counters are recycled, slab
+// memory is never freed.
+struct FGWTCompletionCounter
+{
+    // Allocates counter with the specified initial count
+    static GENERICWORKERTHREAD_API FGWTCompletionCounter* Allocate(int32 InCount);
+
+    // Decrements the counter, returns true once the count reaches zero.
+    // The counter is released to the pool on zero and must not be used.
+    FORCEINLINE bool Decrement()
+    {
+        if (FPlatformAtomics::InterlockedDecrement(&Count) == 0)
+        {
+            Free(this);
+            return true;
+        }
+
+        return false;
+    }
+
+    FORCEINLINE int32 GetCount() const
+    {
+        return FPlatformAtomics::AtomicRead(&Count);
+    }
+
+private:
+
+    volatile int32 Count;
+    uint8 Padding[GWT_CACHE_LINE_SIZE - sizeof(int32)];
+
+    static GENERICWORKERTHREAD_API void Free(FGWTCompletionCounter* Counter);
+};
+
+static_assert(sizeof(FGWTCompletionCounter) == GWT_CACHE_LINE_SIZE, "Completion counter is expected to occupy a single cache line");
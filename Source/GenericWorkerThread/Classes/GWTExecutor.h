@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Common interface of execution contexts, allows work to be retargeted
+// between the game thread, a dedicated thread, a thread pool or a strand.
+class GENERICWORKERTHREAD_API IGWTExecutor
+{
+public:
+
+    typedef TFunction<void()> FExecutorCallback;
+
+    virtual ~IGWTExecutor() = default;
+
+    // Submits callback for execution, never executes the callback on the
+    // calling stack frame (except for the inline executor).
+    // Returns false if the callback is rejected.
+    virtual bool Post(FExecutorCallback Callback) = 0;
+
+    // Submits callback as a continuation of the currently executing work.
+    // Executors may delay deferred callbacks behind posted callbacks or
+    // avoid waking idle threads for them, defaults to post.
+    virtual bool Defer(FExecutorCallback Callback)
+    {
+        return Post(MoveTemp(Callback));
+    }
+
+    // Submits multiple callbacks, executors may submit the whole batch
+    // at once. Returns false if any of the callbacks is rejected.
+    virtual bool BulkPost(TArray<FExecutorCallback>&& Callbacks)
+    {
+        bool bResult = true;
+
+        for (FExecutorCallback& Callback : Callbacks)
+        {
+            bResult &= Post(MoveTemp(Callback));
+        }
+
+        Callbacks.Reset();
+
+        return bResult;
+    }
+
+    // Whether the calling thread is currently executing work of this executor
+    virtual bool IsInExecutorContext() const = 0;
+};
+
+// Executes callbacks immediately on the calling thread
+class GENERICWORKERTHREAD_API FGWTInlineExecutor : public IGWTExecutor
+{
+public:
+
+    static FGWTInlineExecutor& Get()
+    {
+        static FGWTInlineExecutor Executor;
+        return Executor;
+    }
+
+    // -- BEGIN IGWTExecutor
+
+    virtual bool Post(FExecutorCallback Callback) override
+    {
+        if (Callback)
+        {
+            Callback();
+        }
+
+        return true;
+    }
+
+    virtual bool IsInExecutorContext() const override
+    {
+        return true;
+    }
+
+    // -- END IGWTExecutor
+};
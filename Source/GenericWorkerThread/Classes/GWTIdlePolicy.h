@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <emmintrin.h>
+#define GWT_CPU_PAUSE() _mm_pause()
+#else
+#define GWT_CPU_PAUSE()
+#endif
+
+// Idle strategy of worker threads waiting for work.
+//
+// An idle thread first busy spins with CPU pause instructions, then yields
+// its time slice, and finally parks on an event until it is explicitly woken
+// or its wait time runs out. Spinning and yielding keep wake up latency in
+// the microsecond range while parking keeps idle threads off the CPU.
+struct FGWTIdlePolicy
+{
+    // Busy spin duration before yielding, in microseconds
+    float SpinTime = 20.f;
+
+    // Yield duration before parking, in microseconds
+    float YieldTime = 100.f;
+
+    // Park on wake event after the spin and yield phase,
+    // otherwise keep yielding until the wait ends
+    bool bPark = true;
+
+    FGWTIdlePolicy() = default;
+
+    FGWTIdlePolicy(float InSpinTime, float InYieldTime, bool bInPark = true)
+        : SpinTime(FMath::Max(InSpinTime, 0.f))
+        , YieldTime(FMath::Max(InYieldTime, 0.f))
+        , bPark(bInPark)
+    {
+    }
+
+    // Spin then yield until the predicate returns true, the spin and yield
+    // budget runs out, or the end time is reached (negative for no end time).
+    // Returns true if the predicate has been satisfied.
+    template<typename PredicateType>
+    bool SpinYield(PredicateType&& Predicate, double EndTime = -1.0) const
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        const double SpinEndTime  = StartTime + SpinTime * 1e-6;
+        const double YieldEndTime = SpinEndTime + YieldTime * 1e-6;
+
+        double CurrentTime = StartTime;
+
+        while (CurrentTime < SpinEndTime && (EndTime < 0.0 || CurrentTime < EndTime))
+        {
+            for (int32 i=0; i<16; ++i)
+            {
+                GWT_CPU_PAUSE();
+            }
+
+            if (Predicate())
+            {
+                return true;
+            }
+
+            CurrentTime = FPlatformTime::Seconds();
+        }
+
+        while ((! bPark || CurrentTime < YieldEndTime) && (EndTime < 0.0 || CurrentTime < EndTime))
+        {
+            FPlatformProcess::SleepNoStats(0.f);
+
+            if (Predicate())
+            {
+                return true;
+            }
+
+            CurrentTime = FPlatformTime::Seconds();
+        }
+
+        return Predicate();
+    }
+};
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformAtomics.h"
+
+// Lock-free latency histogram with power of two microsecond buckets.
+// Bucket zero holds latencies below two microseconds, bucket N holds
+// latencies in [2^N, 2^(N+1)) microseconds. Counts are cumulative,
+// interval statistics are computed from the difference of two snapshots.
+class FGWTLatencyHistogram
+{
+public:
+
+    static const int32 BucketCount = 32;
+
+    struct FSnapshot
+    {
+        int64 Counts[BucketCount];
+        int64 TotalCount;
+
+        FSnapshot()
+            : TotalCount(0)
+        {
+            FMemory::Memzero(Counts);
+        }
+
+        // Snapshot of counts added since the previous snapshot
+        FSnapshot GetDelta(const FSnapshot& Previous) const
+        {
+            FSnapshot Delta;
+
+            for (int32 i=0; i<BucketCount; ++i)
+            {
+                Delta.Counts[i] = FMath::Max<int64>(Counts[i] - Previous.Counts[i], 0);
+                Delta.TotalCount += Delta.Counts[i];
+            }
+
+            return Delta;
+        }
+
+        // Percentile latency in microseconds, interpolated within its bucket
+        uint32 GetPercentile(double Percentile) const
+        {
+            if (TotalCount <= 0)
+            {
+                return 0;
+            }
+
+            const double TargetCount = FMath::Clamp(Percentile, 0.0, 1.0) * TotalCount;
+            int64 CumulativeCount = 0;
+
+            for (int32 i=0; i<BucketCount; ++i)
+            {
+                if (Counts[i] <= 0)
+                {
+                    continue;
+                }
+
+                if (CumulativeCount + Counts[i] >= TargetCount)
+                {
+                    const double BucketMin = (i > 0) ? static_cast<double>(1ull << i) : 0.0;
+                    const double BucketMax = static_cast<double>(1ull << (i+1));
+                    const double Alpha = (TargetCount - CumulativeCount) / Counts[i];
+                    return static_cast<uint32>(FMath::Min(BucketMin + (BucketMax - BucketMin) * Alpha, static_cast<double>(MAX_uint32)));
+                }
+
+                CumulativeCount += Counts[i];
+            }
+
+            return MAX_uint32;
+        }
+    };
+
+    FGWTLatencyHistogram()
+    {
+        Reset();
+    }
+
+    FORCEINLINE void Add(uint32 LatencyUsec)
+    {
+        const int32 BucketIndex = FMath::Min(static_cast<int32>(FMath::FloorLog2(LatencyUsec | 1u)), BucketCount-1);
+        FPlatformAtomics::InterlockedIncrement(&Counts[BucketIndex]);
+    }
+
+    FORCEINLINE void AddSeconds(double Latency)
+    {
+        Add(static_cast<uint32>(FMath::Clamp(Latency * 1e6, 0.0, static_cast<double>(MAX_uint32))));
+    }
+
+    void GetSnapshot(FSnapshot& OutSnapshot) const
+    {
+        OutSnapshot.TotalCount = 0;
+
+        for (int32 i=0; i<BucketCount; ++i)
+        {
+            OutSnapshot.Counts[i] = FPlatformAtomics::AtomicRead(&Counts[i]);
+            OutSnapshot.TotalCount += OutSnapshot.Counts[i];
+        }
+    }
+
+    void Reset()
+    {
+        for (int32 i=0; i<BucketCount; ++i)
+        {
+            FPlatformAtomics::InterlockedExchange(&Counts[i], 0);
+        }
+    }
+
+private:
+
+    volatile int64 Counts[BucketCount];
+};
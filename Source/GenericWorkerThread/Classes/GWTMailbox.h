@@ -0,0 +1,296 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include "GWTExecutor.h"
+#include "GWTMpscQueue.h"
+#include "GWTTrace.h"
+
+// Identifies the mailbox processing messages on the calling thread
+class GENERICWORKERTHREAD_API FGWTMailboxContext
+{
+public:
+
+    static const void* GetCurrent();
+    static void SetCurrent(const void* Mailbox);
+};
+
+// Actor-style mailbox. Messages posted to the mailbox are handled one at
+// a time in posting order on any thread of the underlying executor, the
+// mailbox only occupies an executor thread while it has pending messages.
+//
+// Posting a message allocates a single queue node and is lock-free. The
+// first message posted to an idle mailbox schedules message processing
+// on the executor, which yields the executor after max batch count
+// messages. Messages are handled on the posting thread if the executor
+// rejects the mailbox.
+//
+// The underlying executor must outlive the mailbox. Pending messages keep
+// the mailbox alive until they are handled.
+template<typename MessageType>
+class TGWTMailbox : public TSharedFromThis<TGWTMailbox<MessageType>, ESPMode::ThreadSafe>
+{
+public:
+
+    typedef TFunction<void(MessageType&)>                             FMessageHandler;
+    typedef TSharedRef<TGWTMailbox<MessageType>, ESPMode::ThreadSafe> FMailboxRef;
+
+private:
+
+    struct FMessageNode : public FGWTMpscNode
+    {
+        MessageType Message;
+
+        template<typename ArgType>
+        explicit FMessageNode(ArgType&& InMessage)
+            : Message(Forward<ArgType>(InMessage))
+        {
+        }
+    };
+
+    IGWTExecutor& Executor;
+    FMessageHandler MessageHandler;
+    TGWTIntrusiveMpscQueue<FMessageNode> MessageQueue;
+    volatile int32 PendingCount;
+    int32 MaxBatchCount;
+
+    TGWTMailbox(IGWTExecutor& InExecutor, FMessageHandler&& InMessageHandler, int32 InMaxBatchCount)
+        : Executor(InExecutor)
+        , MessageHandler(MoveTemp(InMessageHandler))
+        , PendingCount(0)
+        , MaxBatchCount(FMath::Max(InMaxBatchCount, 1))
+    {
+        check(MessageHandler);
+    }
+
+    void PushNode(FMessageNode* Node)
+    {
+        MessageQueue.Push(Node);
+
+        // First pending message schedules mailbox processing
+        if (FPlatformAtomics::InterlockedIncrement(&PendingCount) == 1 && ! Schedule(false))
+        {
+            ProcessMessages();
+        }
+    }
+
+    bool Schedule(bool bIsContinuation)
+    {
+        FMailboxRef Mailbox(this->AsShared());
+
+        IGWTExecutor::FExecutorCallback MailboxCallback(
+            [Mailbox]()
+            {
+                Mailbox->ProcessMessages();
+            } );
+
+        return bIsContinuation
+            ? Executor.Defer(MoveTemp(MailboxCallback))
+            : Executor.Post(MoveTemp(MailboxCallback));
+    }
+
+    void ProcessMessages()
+    {
+        GWT_TRACE_SCOPE("GWT.Mailbox.Process");
+
+        const void* PreviousMailbox = FGWTMailboxContext::GetCurrent();
+        FGWTMailboxContext::SetCurrent(this);
+
+        for (;;)
+        {
+            int32 HandledCount = 0;
+            int32 RemainingCount;
+
+            do
+            {
+                FMessageNode* Node;
+
+                // Producer may have counted its message before the
+                // node is linked, wait for the node to be visible
+                while ((Node = MessageQueue.Pop()) == nullptr)
+                {
+                    FPlatformProcess::Yield();
+                }
+
+                MessageHandler(Node->Message);
+                delete Node;
+
+                ++HandledCount;
+
+                RemainingCount = FPlatformAtomics::InterlockedDecrement(&PendingCount);
+            }
+            while (RemainingCount > 0 && HandledCount < MaxBatchCount);
+
+            // Batch limit reached, yield executor to other work.
+            // Continue on the current thread if the executor rejects
+            // the continuation to keep the mailbox from stalling.
+            if (RemainingCount <= 0 || Schedule(true))
+            {
+                break;
+            }
+        }
+
+        FGWTMailboxContext::SetCurrent(PreviousMailbox);
+    }
+
+public:
+
+    static FMailboxRef Create(IGWTExecutor& InExecutor, FMessageHandler InMessageHandler, int32 InMaxBatchCount = 64)
+    {
+        return MakeShareable(new TGWTMailbox<MessageType>(InExecutor, MoveTemp(InMessageHandler), InMaxBatchCount));
+    }
+
+    ~TGWTMailbox()
+    {
+        while (FMessageNode* Node = MessageQueue.Pop())
+        {
+            delete Node;
+        }
+    }
+
+    FORCEINLINE IGWTExecutor& GetExecutor() const
+    {
+        return Executor;
+    }
+
+    FORCEINLINE int32 GetPendingCount() const
+    {
+        return FPlatformAtomics::AtomicRead(&PendingCount);
+    }
+
+    // Whether the calling thread is currently handling messages of this mailbox
+    FORCEINLINE bool IsInMailboxContext() const
+    {
+        return FGWTMailboxContext::GetCurrent() == this;
+    }
+
+    FORCEINLINE void Post(const MessageType& Message)
+    {
+        PushNode(new FMessageNode(Message));
+    }
+
+    FORCEINLINE void Post(MessageType&& Message)
+    {
+        PushNode(new FMessageNode(MoveTemp(Message)));
+    }
+
+    // Posts messages in order, schedules mailbox processing at most once
+    void BulkPost(TArray<MessageType>&& Messages)
+    {
+        const int32 MessageCount = Messages.Num();
+
+        if (MessageCount == 0)
+        {
+            return;
+        }
+
+        for (MessageType& Message : Messages)
+        {
+            MessageQueue.Push(new FMessageNode(MoveTemp(Message)));
+        }
+
+        Messages.Reset();
+
+        if (FPlatformAtomics::InterlockedAdd(&PendingCount, MessageCount) == 0 && ! Schedule(false))
+        {
+            ProcessMessages();
+        }
+    }
+};
+
+typedef TSharedPtr<class FGWTStrandExecutor, ESPMode::ThreadSafe> FPSGWTStrandExecutor;
+typedef TSharedRef<class FGWTStrandExecutor, ESPMode::ThreadSafe> FPRGWTStrandExecutor;
+
+// Serializes callbacks on top of another executor without a dedicated
+// thread, callbacks are executed through a mailbox of callbacks.
+// Callbacks are executed one at a time in submission order, possibly on
+// different threads of the underlying executor.
+//
+// The underlying executor must outlive the strand.
+class FGWTStrandExecutor : public IGWTExecutor
+{
+    typedef TGWTMailbox<FExecutorCallback> FCallbackMailbox;
+
+    FCallbackMailbox::FMailboxRef Mailbox;
+
+    FGWTStrandExecutor(IGWTExecutor& InExecutor, int32 InMaxBatchCount)
+        : Mailbox(FCallbackMailbox::Create(
+            InExecutor,
+            [](FExecutorCallback& Callback)
+            {
+                if (Callback)
+                {
+                    Callback();
+                }
+            },
+            InMaxBatchCount ))
+    {
+    }
+
+public:
+
+    // Creates strand on top of the specified executor. Strand yields the
+    // underlying executor after executing max batch count callbacks.
+    static FPRGWTStrandExecutor Create(IGWTExecutor& InExecutor, int32 InMaxBatchCount = 64)
+    {
+        return MakeShareable(new FGWTStrandExecutor(InExecutor, InMaxBatchCount));
+    }
+
+    FORCEINLINE IGWTExecutor& GetExecutor() const
+    {
+        return Mailbox->GetExecutor();
+    }
+
+    FORCEINLINE int32 GetPendingCount() const
+    {
+        return Mailbox->GetPendingCount();
+    }
+
+    // -- BEGIN IGWTExecutor
+
+    virtual bool Post(FExecutorCallback Callback) override
+    {
+        Mailbox->Post(MoveTemp(Callback));
+        return true;
+    }
+
+    virtual bool BulkPost(TArray<FExecutorCallback>&& Callbacks) override
+    {
+        Mailbox->BulkPost(MoveTemp(Callbacks));
+        return true;
+    }
+
+    virtual bool IsInExecutorContext() const override
+    {
+        return Mailbox->IsInMailboxContext();
+    }
+
+    // -- END IGWTExecutor
+};
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformAtomics.h"
+#include "Templates/IsDerivedFrom.h"
+
+// Intrusive queue node, queued types derive from this node
+struct FGWTMpscNode
+{
+    FGWTMpscNode* volatile NextNode = nullptr;
+};
+
+// Intrusive unbounded multi-producer single-consumer lock-free queue.
+//
+// Push is a single atomic exchange and never allocates, nodes are owned
+// by the caller. Pop may transiently return null while a concurrent push
+// has swapped the queue head but not yet linked its node, consumers that
+// track pending node count separately are expected to retry.
+template<typename NodeType>
+class TGWTIntrusiveMpscQueue
+{
+    static_assert(TIsDerivedFrom<NodeType, FGWTMpscNode>::IsDerived, "Queue node type must derive from FGWTMpscNode");
+
+    // Producer side
+    FGWTMpscNode* volatile Head;
+
+    // Consumer side
+    FGWTMpscNode* Tail;
+
+    FGWTMpscNode Stub;
+
+    FORCEINLINE void PushNode(FGWTMpscNode* Node)
+    {
+        Node->NextNode = nullptr;
+        FGWTMpscNode* PrevNode = (FGWTMpscNode*) FPlatformAtomics::InterlockedExchangePtr((void**)&Head, Node);
+        FPlatformAtomics::InterlockedExchangePtr((void**)&PrevNode->NextNode, Node);
+    }
+
+public:
+
+    TGWTIntrusiveMpscQueue()
+        : Head(&Stub)
+        , Tail(&Stub)
+    {
+    }
+
+    TGWTIntrusiveMpscQueue(const TGWTIntrusiveMpscQueue&) = delete;
+    TGWTIntrusiveMpscQueue& operator=(const TGWTIntrusiveMpscQueue&) = delete;
+
+    // Any thread
+    FORCEINLINE void Push(NodeType* Node)
+    {
+        check(Node != nullptr);
+        PushNode(Node);
+    }
+
+    // Consumer thread only
+    NodeType* Pop()
+    {
+        FGWTMpscNode* TailNode = Tail;
+        FGWTMpscNode* NextNode = TailNode->NextNode;
+
+        // Skip stub node
+        if (TailNode == &Stub)
+        {
+            if (NextNode == nullptr)
+            {
+                return nullptr;
+            }
+
+            Tail = NextNode;
+            TailNode = NextNode;
+            NextNode = NextNode->NextNode;
+        }
+
+        if (NextNode != nullptr)
+        {
+            Tail = NextNode;
+            return static_cast<NodeType*>(TailNode);
+        }
+
+        // Push in progress, last node is not yet linked
+        if (TailNode != Head)
+        {
+            return nullptr;
+        }
+
+        // Tail is the last node, requeue stub node behind it before pop
+        PushNode(&Stub);
+
+        NextNode = TailNode->NextNode;
+
+        if (NextNode != nullptr)
+        {
+            Tail = NextNode;
+            return static_cast<NodeType*>(TailNode);
+        }
+
+        return nullptr;
+    }
+
+    // Consumer thread only
+    FORCEINLINE bool IsEmpty() const
+    {
+        return Tail == &Stub && Stub.NextNode == nullptr;
+    }
+};
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "UObject/Package.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "GWTObjectPool.generated.h"
+
+class UGWTTaskEventObject;
+class UGWTAsyncTaskObject;
+class UGWTPromiseObject;
+class UGWTTickEvent;
+
+// Recycles task wrapper objects to avoid UObject allocation and garbage
+// collection churn. Pooled objects are kept alive by the pool while free,
+// acquired objects must be referenced by the caller as usual.
+// Game thread only.
+class GENERICWORKERTHREAD_API FGWTObjectPool : public FGCObject
+{
+    TMap<UClass*, TArray<UObject*>> FreeObjects;
+    int32 MaxFreeObjectCount;
+
+    int32 AllocatedCount;
+    int32 ReusedCount;
+
+    UObject* PopFreeObject(UClass* ObjectClass);
+
+public:
+
+    FGWTObjectPool();
+
+    // -- BEGIN FGCObject
+
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+    virtual FString GetReferencerName() const
+    {
+        return TEXT("FGWTObjectPool");
+    }
+
+    // -- END FGCObject
+
+    template<class ObjectType>
+    ObjectType* Acquire()
+    {
+        check(IsInGameThread());
+
+        if (UObject* FreeObject = PopFreeObject(ObjectType::StaticClass()))
+        {
+            ++ReusedCount;
+            return CastChecked<ObjectType>(FreeObject);
+        }
+
+        ++AllocatedCount;
+        return NewObject<ObjectType>(GetTransientPackage());
+    }
+
+    // Returns object to the pool. Objects that are still in use or exceed
+    // the pool capacity are left to the garbage collector, returns false
+    // in that case. Released object must not be used by the caller.
+    bool Release(UObject* Object);
+
+    void Empty();
+
+    // Maximum number of free objects kept per object class
+    FORCEINLINE void SetMaxFreeObjectCount(int32 InMaxFreeObjectCount)
+    {
+        check(InMaxFreeObjectCount >= 0);
+        MaxFreeObjectCount = InMaxFreeObjectCount;
+    }
+
+    FORCEINLINE int32 GetMaxFreeObjectCount() const
+    {
+        return MaxFreeObjectCount;
+    }
+
+    int32 GetFreeObjectCount() const;
+
+    FORCEINLINE int32 GetAllocatedCount() const
+    {
+        return AllocatedCount;
+    }
+
+    FORCEINLINE int32 GetReusedCount() const
+    {
+        return ReusedCount;
+    }
+};
+
+UCLASS()
+class GENERICWORKERTHREAD_API UGWTObjectPoolLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+
+    UFUNCTION(BlueprintCallable)
+    static UGWTTaskEventObject* AcquireTaskEventObject();
+
+    UFUNCTION(BlueprintCallable)
+    static UGWTAsyncTaskObject* AcquireAsyncTaskObject();
+
+    UFUNCTION(BlueprintCallable)
+    static UGWTPromiseObject* AcquirePromiseObject();
+
+    UFUNCTION(BlueprintCallable)
+    static UGWTTickEvent* AcquireTickEvent();
+
+    // Returns object to the pool, object must not be used afterwards
+    UFUNCTION(BlueprintCallable)
+    static bool ReleaseObject(UObject* Object);
+};
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GWTAsyncThreadPool.h"
+
+class FGWTTaskGroupNode;
+
+// Execution scope of a task group task, allows the executing task to spawn
+// child tasks into the task group thread pool. A scope is only valid during
+// execution of its task function.
+class GENERICWORKERTHREAD_API FGWTTaskScope
+{
+    friend class FGWTTaskGroupNode;
+
+    FGWTTaskGroupNode& Node;
+
+    explicit FGWTTaskScope(FGWTTaskGroupNode& InNode)
+        : Node(InNode)
+    {
+    }
+
+public:
+
+    FGWTTaskScope(const FGWTTaskScope&) = delete;
+    FGWTTaskScope& operator=(const FGWTTaskScope&) = delete;
+
+    // Spawns child task of the executing task. The executing task is only
+    // completed once its own function and all of its descendant tasks have
+    // completed. Child task is executed on the calling thread if the thread
+    // pool does not accept the work.
+    void Spawn(FGWTTaskGroupFunction Function);
+
+    // Whether the task group has been cancelled, spawned tasks that have
+    // not yet started are skipped once the group has been cancelled
+    bool IsCancelled() const;
+
+    FGWTAsyncThreadPool& GetThreadPool() const;
+};
+
+// Structured task group. Tasks are executed on the thread pool and may spawn
+// child tasks which are joined by the spawning task through pending counters
+// instead of blocking, the group completes once the root task and all of its
+// descendant tasks have completed.
+class GENERICWORKERTHREAD_API FGWTTaskGroup
+{
+public:
+
+    // Launches task group root task. Completion callback is executed on the
+    // thread that completes the last task of the group. Task state is used
+    // as the group cancellation state, the group is cancelled once the state
+    // is set to cancelled.
+    static void Launch(
+        FGWTAsyncThreadPool& ThreadPool,
+        FGWTTaskGroupFunction RootFunction,
+        TFunction<void()> CompletionCallback,
+        const FPRGWTAsyncTaskState& TaskState
+        )
+    {
+        GWTLaunchTaskGroup(ThreadPool, MoveTemp(RootFunction), MoveTemp(CompletionCallback), TaskState);
+    }
+
+    // Launches task group root task, returned future is ready once the root
+    // task and all of its descendant tasks have completed
+    static TFuture<void> Launch(FGWTAsyncThreadPool& ThreadPool, FGWTTaskGroupFunction RootFunction);
+};
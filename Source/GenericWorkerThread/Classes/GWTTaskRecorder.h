@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformAtomics.h"
+
+// Recorded task chain, times are in microseconds since recording start.
+// Chain ids are unique across recordings of the same process, ids of
+// a recording are ascending but do not necessarily start at one.
+struct FGWTRecordedChain
+{
+    uint32 ChainId = 0;
+    uint64 SubmitTime = 0;
+    uint16 StageCount = 0;
+
+    friend FArchive& operator<<(FArchive& Ar, FGWTRecordedChain& Chain)
+    {
+        Ar << Chain.ChainId;
+        Ar << Chain.SubmitTime;
+        Ar << Chain.StageCount;
+        return Ar;
+    }
+};
+
+// Recorded task of a task chain stage, times are in microseconds
+// since recording start, durations saturate at about 71 minutes. Tasks of the same stage execute concurrently,
+// a stage starts once every task of the previous stage has completed.
+struct FGWTRecordedTask
+{
+    uint32 ChainId = 0;
+    uint16 StageIndex = 0;
+    uint16 TaskIndex = 0;
+    uint64 StartTime = 0;
+    uint32 Duration = 0;
+
+    friend FArchive& operator<<(FArchive& Ar, FGWTRecordedTask& Task)
+    {
+        Ar << Task.ChainId;
+        Ar << Task.StageIndex;
+        Ar << Task.TaskIndex;
+        Ar << Task.StartTime;
+        Ar << Task.Duration;
+        return Ar;
+    }
+};
+
+struct GENERICWORKERTHREAD_API FGWTTaskRecording
+{
+    TArray<FGWTRecordedChain> Chains;
+    TArray<FGWTRecordedTask> Tasks;
+
+    bool SaveToFile(const FString& FilePath);
+    bool LoadFromFile(const FString& FilePath);
+
+    friend GENERICWORKERTHREAD_API FArchive& operator<<(FArchive& Ar, FGWTTaskRecording& Recording);
+};
+
+// Records task graph structure and task timings of enqueued FGWTAsyncTaskRef
+// task chains. Records are collected through lock-free queues, tasks that
+// have been skipped due to cancellation are not recorded. Task group stages
+// are recorded as a single task spanning the group root task start to the
+// group completion.
+class GENERICWORKERTHREAD_API FGWTTaskRecorder
+{
+    static volatile int32 bIsRecording;
+
+public:
+
+    FORCEINLINE static bool IsRecording()
+    {
+        return FPlatformAtomics::AtomicRead(&bIsRecording) != 0;
+    }
+
+    // Starts recording, discards records of the previous recording
+    static void Start();
+    static void Stop();
+
+    // Returns records collected since recording start
+    static void GetRecording(FGWTTaskRecording& OutRecording);
+
+    // Writes records collected since recording start as binary file
+    static bool Export(const FString& FilePath);
+
+    // Registers new task chain, returns zero if not recording
+    static uint32 BeginChain(int32 StageCount);
+
+    static void RecordTask(uint32 ChainId, int32 StageIndex, int32 TaskIndex, double StartTime, double EndTime);
+
+    // Wraps task callback to record its execution time
+    static TFunction<void()> WrapTask(TFunction<void()> TaskCallback, uint32 ChainId, int32 StageIndex, int32 TaskIndex);
+};
+
+struct FGWTTaskReplayResult
+{
+    int32 WorkerCount = 0;
+    int32 ChainCount = 0;
+    int32 TaskCount = 0;
+
+    // Time from the first chain submission to the last task completion
+    double Makespan = 0.0;
+
+    // Sum of simulated task durations
+    double TotalTaskTime = 0.0;
+
+    // Busy worker time over available worker time
+    double Utilization = 0.0;
+
+    double AverageChainLatency = 0.0;
+    double MaxChainLatency = 0.0;
+
+    // Time tasks spent ready without an available worker
+    double AverageQueueWait = 0.0;
+    double MaxQueueWait = 0.0;
+};
+
+// Deterministic replay of recorded task graphs. Replays the recorded chain
+// submissions and stage dependencies on a simulated worker count, executing
+// ready tasks in first-in first-out order with synthetic task durations.
+// Simulation runs on the calling thread without executing any task.
+class GENERICWORKERTHREAD_API FGWTTaskReplay
+{
+public:
+
+    // Returns simulated task duration in seconds
+    typedef TFunction<double(const FGWTRecordedTask&)> FDurationFunction;
+
+    // Simulates recording on the worker count. Recorded task durations
+    // are used if no duration function is specified.
+    static FGWTTaskReplayResult Simulate(
+        const FGWTTaskRecording& Recording,
+        int32 WorkerCount,
+        const FDurationFunction& DurationFunction = FDurationFunction()
+        );
+
+    // Recorded task duration multiplied by the scale
+    static FDurationFunction ScaledDuration(double Scale);
+};
@@ -27,6 +27,10 @@
 
 #pragma once
 
+#include "Containers/Array.h"
+#include "Containers/List.h"
+#include "Containers/UnrealString.h"
+#include "Templates/Function.h"
 #include "Templates/SharedPointer.h"
 
 typedef TSharedPtr<class IGWTTaskWorker> FPSGWTTaskWorker;
@@ -37,6 +41,37 @@ class IGWTTaskWorker
     friend class FGWTAsyncThread;
     int32 _TaskWorkerId = -1;
 
+    // Registration on the owning thread worker list. Owning thread is
+    // swapped atomically, while the worker is handed between threads it
+    // holds one of the FGWTAsyncThread handoff markers instead.
+    class FGWTAsyncThread* volatile _OwningThread = nullptr;
+    TDoubleLinkedList<FPWGWTTaskWorker>::TDoubleLinkedListNode* _WorkerListNode = nullptr;
+
+    // Resolves removal requested while the worker is handed between threads,
+    // executed by the adopting thread or on worker destruction
+    TFunction<void()> _PendingRemoval;
+
+    int32 TickGroup = 0;
+    TArray<FPWGWTTaskWorker> TickPrerequisites;
+
+    double _LastTickTime = 0.0;
+    double _TickTimeAccumulator = 0.0;
+
+    // Moving average of tick execution time, used for load balancing
+    double _AverageTickCost = 0.0;
+
+    // Set if any worker on the same thread requires this worker as prerequisite
+    bool _bHasTickDependents = false;
+
+    float TickBudget = 0.f;
+    int32 TickInterval = 1;
+    int32 _TickIntervalCounter = 0;
+    int32 _OverrunCount = 0;
+    int32 _ConsecutiveOverrunCount = 0;
+
+    float FixedTimeStep = 0.f;
+    int32 MaxSubsteps = 8;
+
     virtual bool operator==(const IGWTTaskWorker& rhs) const
     {
         return _TaskWorkerId == rhs._TaskWorkerId;
@@ -44,6 +79,15 @@ class IGWTTaskWorker
 
 public:
 
+    virtual ~IGWTTaskWorker()
+    {
+        // Worker expired before the adopting thread could apply its removal
+        if (_PendingRemoval)
+        {
+            _PendingRemoval();
+        }
+    }
+
     virtual void SetupTaskWorker()
     {
     }
@@ -54,4 +98,128 @@ public:
 
     virtual void Tick(float DeltaTime) = 0;
 
+    // Worker identity used in diagnostic logs
+    virtual FString GetWorkerName() const
+    {
+        return FString::Printf(TEXT("TaskWorker_%d"), _TaskWorkerId);
+    }
+
+    // Tick Ordering
+    //
+    // Workers tick in ascending tick group order. Within the same tick group,
+    // a worker ticks after all of its prerequisites that are registered on
+    // the same thread. Tick order should be configured before the worker is
+    // added to a thread, otherwise the thread tick schedule has to be
+    // invalidated explicitly.
+
+    FORCEINLINE int32 GetTickGroup() const
+    {
+        return TickGroup;
+    }
+
+    FORCEINLINE void SetTickGroup(int32 InTickGroup)
+    {
+        TickGroup = InTickGroup;
+    }
+
+    FORCEINLINE const TArray<FPWGWTTaskWorker>& GetTickPrerequisites() const
+    {
+        return TickPrerequisites;
+    }
+
+    void AddTickPrerequisite(const FPSGWTTaskWorker& Worker)
+    {
+        if (Worker.IsValid() && Worker.Get() != this)
+        {
+            TickPrerequisites.AddUnique(Worker);
+        }
+    }
+
+    void RemoveTickPrerequisite(const FPSGWTTaskWorker& Worker)
+    {
+        TickPrerequisites.Remove(Worker);
+    }
+
+    // Moving average of the worker tick execution time in seconds
+    FORCEINLINE double GetAverageTickCost() const
+    {
+        return _AverageTickCost;
+    }
+
+    // Workers bound by tick ordering are never migrated between threads,
+    // workers bound to their hosting thread may opt out of migration
+    virtual bool IsMigratable() const
+    {
+        return TickPrerequisites.Num() == 0 && ! _bHasTickDependents;
+    }
+
+    // Tick Budget
+    //
+    // With a positive tick budget, each thread loop tick of the worker that
+    // takes longer than the budget counts as an overrun. Chronic overruns
+    // are handled according to the owning thread overrun policy.
+
+    FORCEINLINE float GetTickBudget() const
+    {
+        return TickBudget;
+    }
+
+    FORCEINLINE void SetTickBudget(float InTickBudget)
+    {
+        TickBudget = FMath::Max(InTickBudget, 0.f);
+    }
+
+    FORCEINLINE int32 GetOverrunCount() const
+    {
+        return _OverrunCount;
+    }
+
+    // Number of thread loops per worker tick, delta time spans skipped loops
+    FORCEINLINE int32 GetTickInterval() const
+    {
+        return TickInterval;
+    }
+
+    FORCEINLINE void SetTickInterval(int32 InTickInterval)
+    {
+        TickInterval = FMath::Max(InTickInterval, 1);
+    }
+
+    // Fixed Time Step
+    //
+    // With a positive fixed time step, elapsed time is accumulated and the
+    // worker is ticked with constant delta time as many times as the
+    // accumulated time allows, up to the max substep count per thread loop.
+    // Accumulated time beyond the substep cap is discarded.
+
+    FORCEINLINE bool IsFixedTimeStep() const
+    {
+        return FixedTimeStep > 0.f;
+    }
+
+    FORCEINLINE float GetFixedTimeStep() const
+    {
+        return FixedTimeStep;
+    }
+
+    FORCEINLINE int32 GetMaxSubsteps() const
+    {
+        return MaxSubsteps;
+    }
+
+    void SetFixedTimeStep(float InFixedTimeStep, int32 InMaxSubsteps = 8)
+    {
+        FixedTimeStep = FMath::Max(InFixedTimeStep, 0.f);
+        MaxSubsteps = FMath::Max(InMaxSubsteps, 1);
+        _TickTimeAccumulator = 0.0;
+    }
+
+protected:
+
+    // Hosting thread, only valid within worker setup, tick and shutdown
+    // before the worker is detached from the thread
+    FORCEINLINE class FGWTAsyncThread* GetOwningThread() const
+    {
+        return _OwningThread;
+    }
 };
@@ -0,0 +1,259 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeLock.h"
+#include "GWTAsyncThread.h"
+#include "GWTAsyncThreadPool.h"
+#include "GWTLatencyHistogram.h"
+#include "GWTTaskWorker.h"
+
+enum class EGWTTelemetrySource : uint8
+{
+    ThreadPool,
+    Thread
+};
+
+// Fixed size telemetry record of a single source over a sample interval.
+// A record is valid once its sequence matches the expected ring sequence,
+// the sequence is cleared while the record is being written.
+struct FGWTTelemetryRecord
+{
+    uint64 Sequence;
+
+    // Sample time in milliseconds since unix epoch
+    int64 Timestamp;
+
+    uint8 SourceType;
+    uint8 Reserved[3];
+
+    // Thread pool queue depth, zero for threads
+    int32 QueueDepth;
+
+    // Work completed during the sample interval, zero for threads
+    uint32 CompletedCount;
+
+    // Work latency percentiles during the sample interval, zero for threads
+    uint32 P50LatencyUsec;
+    uint32 P99LatencyUsec;
+
+    // Thread average loop tick cost, thread pool average work time
+    uint32 TickCostUsec;
+
+    // Thread worker count, thread pool worker thread count
+    int32 WorkerCount;
+
+    // Null terminated source name, truncated if required
+    ANSICHAR SourceName[20];
+
+    FORCEINLINE EGWTTelemetrySource GetSourceType() const
+    {
+        return static_cast<EGWTTelemetrySource>(SourceType);
+    }
+
+    FString GetSourceName() const
+    {
+        ANSICHAR Name[sizeof(SourceName)+1];
+        FMemory::Memcpy(Name, SourceName, sizeof(SourceName));
+        Name[sizeof(SourceName)] = 0;
+        return FString(ANSI_TO_TCHAR(Name));
+    }
+};
+
+static_assert(sizeof(FGWTTelemetryRecord) == 64, "Telemetry record size is part of the telemetry file format");
+
+// Telemetry ring file header, followed by record capacity records
+struct FGWTTelemetryHeader
+{
+    static const uint32 FileMagic = 0x4D4C5447; // GTLM
+    static const uint32 FileVersion = 1;
+
+    uint32 Magic;
+    uint32 Version;
+    uint32 RecordSize;
+    uint32 RecordCapacity;
+
+    // Number of records written since the file has been created
+    volatile uint64 WriteCount;
+
+    // File creation time in milliseconds since unix epoch
+    int64 CreateTime;
+
+    uint8 Reserved[32];
+};
+
+static_assert(sizeof(FGWTTelemetryHeader) == 64, "Telemetry header size is part of the telemetry file format");
+
+// Memory mapped file region, implemented per platform
+class FGWTMappedFile;
+
+// Single writer of a memory mapped telemetry ring file. Records are written
+// directly to the mapped file, leaving flushing to the operating system,
+// so records written before a crash remain readable. Existing file with
+// matching format is appended to, wrapping around once the ring is full.
+class GENERICWORKERTHREAD_API FGWTTelemetryWriter
+{
+public:
+
+    FGWTTelemetryWriter();
+    ~FGWTTelemetryWriter();
+
+    bool Open(const FString& FilePath, uint32 RecordCapacity);
+    void Close();
+
+    FORCEINLINE bool IsOpen() const
+    {
+        return Header != nullptr;
+    }
+
+    // Writes record, record sequence is assigned by the writer
+    void Write(const FGWTTelemetryRecord& Record);
+
+private:
+
+    TUniquePtr<FGWTMappedFile> MappedFile;
+    FGWTTelemetryHeader* Header;
+    FGWTTelemetryRecord* Records;
+};
+
+// Reader of a telemetry ring file, either after the writing process has
+// exited or while the writing process is still live. Records overwritten
+// or being written during the read are skipped.
+class GENERICWORKERTHREAD_API FGWTTelemetryReader
+{
+public:
+
+    FGWTTelemetryReader();
+    ~FGWTTelemetryReader();
+
+    bool Open(const FString& FilePath);
+    void Close();
+
+    FORCEINLINE bool IsOpen() const
+    {
+        return Header != nullptr;
+    }
+
+    uint64 GetWriteCount() const;
+
+    // Reads records with sequence greater than the specified sequence in
+    // sequence order, returns the last read sequence. Pass the returned
+    // sequence on the next read to follow a live file.
+    uint64 ReadRecords(TArray<FGWTTelemetryRecord>& OutRecords, uint64 AfterSequence = 0) const;
+
+private:
+
+    TUniquePtr<FGWTMappedFile> MappedFile;
+    const FGWTTelemetryHeader* Header;
+    const FGWTTelemetryRecord* Records;
+};
+
+typedef TSharedPtr<class FGWTTelemetryWorker> FPSGWTTelemetryWorker;
+
+// Task worker that samples registered thread pools and threads each sample
+// interval and writes their statistics to a telemetry ring file. The worker
+// lowers the priority of its hosting thread on setup and restores it on
+// shutdown, the worker is expected to run on its own thread. The worker is never migrated and excludes its
+// hosting thread from load balancing while registered.
+class GENERICWORKERTHREAD_API FGWTTelemetryWorker : public IGWTTaskWorker
+{
+public:
+
+    FGWTTelemetryWorker(float InSampleInterval = 1.f, bool bInLowerThreadPriority = true);
+
+    // Creates worker writing to the specified file, returns null if the
+    // telemetry file could not be opened
+    static FPSGWTTelemetryWorker Create(
+        const FString& FilePath,
+        float SampleInterval = 1.f,
+        uint32 RecordCapacity = 64 * 1024,
+        bool bLowerThreadPriority = true
+        );
+
+    FORCEINLINE FGWTTelemetryWriter& GetWriter()
+    {
+        return Writer;
+    }
+
+    // Source registration, safe to call from any thread
+
+    void AddThreadPool(FName SourceName, const FPSGWTAsyncThreadPool& ThreadPool);
+    void AddThread(FName SourceName, const FPSGWTAsyncThread& Thread);
+    void RemoveSource(FName SourceName);
+
+    // -- BEGIN IGWTTaskWorker
+
+    virtual void SetupTaskWorker() override;
+    virtual void ShutdownTaskWorker() override;
+    virtual void Tick(float DeltaTime) override;
+
+    virtual FString GetWorkerName() const override
+    {
+        return TEXT("GWTTelemetryWorker");
+    }
+
+    virtual bool IsMigratable() const override
+    {
+        return false;
+    }
+
+    // -- END IGWTTaskWorker
+
+private:
+
+    struct FPoolSource
+    {
+        FName SourceName;
+        FPWGWTAsyncThreadPool ThreadPool;
+        FGWTLatencyHistogram::FSnapshot LastSnapshot;
+        int64 LastCompletedCount = 0;
+    };
+
+    struct FThreadSource
+    {
+        FName SourceName;
+        FPWGWTAsyncThread Thread;
+    };
+
+    FGWTTelemetryWriter Writer;
+    FGWTAsyncThread* HostThread;
+    float SampleInterval;
+    float SampleTimeAccumulator;
+    bool bLowerThreadPriority;
+
+    FRunnableThread* LoweredThread;
+    EThreadPriority PrevThreadPriority;
+
+    FCriticalSection SourceLock;
+    TArray<FPoolSource> PoolSources;
+    TArray<FThreadSource> ThreadSources;
+
+    void WriteSamples();
+};
@@ -28,10 +28,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GWTAsyncTypes.h"
+#include "GWTExecutor.h"
 
 class UGWTTickEvent;
 
-class GENERICWORKERTHREAD_API FGWTTickManager
+class GENERICWORKERTHREAD_API FGWTTickManager : public IGWTExecutor
 {
 public:
 
@@ -42,10 +44,28 @@ private:
 	FTickerDelegate TickDelegate;
 	FDelegateHandle TickDelegateHandle;
 
+    // Bounded queue state, capacity of zero means unbounded
+    int32 QueueCapacity;
+    EGWTQueueOverflowPolicy OverflowPolicy;
+    volatile int32 QueueDepth;
+    volatile int32 PeakQueueDepth;
+    FThreadSafeCounter RejectedCount;
+    FThreadSafeCounter DroppedCount;
+    FThreadSafeCounter InlineCount;
+
+    void DropOverflowCallbacks();
+    void WaitForQueueCapacity();
+
 protected:
 
     TQueue<FTickCallback, EQueueMode::Mpsc> CallbackQueue;
 
+    // Deferred executor callbacks, executed on the next tick
+    TQueue<FTickCallback, EQueueMode::Mpsc> DeferredCallbackQueue;
+
+    // Dirty tick events, each event is queued at most once per tick
+    TQueue<TWeakObjectPtr<UGWTTickEvent>, EQueueMode::Mpsc> TickEventQueue;
+
 	virtual bool Tick(float DeltaTime);
 
 public:
@@ -54,6 +74,105 @@ public:
     virtual ~FGWTTickManager();
 
     void ExecuteCallbacks();
-    void EnqueueTickCallback(const FTickCallback& TickCallback);
-    void EnqueueTickEvent(UGWTTickEvent* TickEvent);
+
+    // Executes callbacks deferred before the current tick
+    void ExecuteDeferredCallbacks();
+
+    // Broadcasts tick events marked dirty since the last tick,
+    // events marked dirty during broadcast are deferred to the next tick.
+    // Each tick executes queued callbacks, then deferred callbacks, then
+    // tick events. Tick events are no longer ordered with the callbacks
+    // enqueued around them, listeners observe all callbacks of the tick.
+    void ExecuteTickEvents();
+
+    // Returns false if the callback is rejected by a full callback queue
+    bool EnqueueTickCallback(const FTickCallback& TickCallback);
+
+    // Marks tick event dirty, multiple enqueue of the same event within
+    // a single tick are coalesced into a single broadcast. Tick events
+    // are not subject to the callback queue limit.
+    bool EnqueueTickEvent(UGWTTickEvent* TickEvent);
+
+    // -- BEGIN IGWTExecutor
+
+    // Posted callbacks are subject to the callback queue limit,
+    // deferred callbacks are not and are always executed on the next tick
+
+    virtual bool Post(FExecutorCallback Callback) override
+    {
+        return EnqueueTickCallback(Callback);
+    }
+
+    virtual bool Defer(FExecutorCallback Callback) override
+    {
+        DeferredCallbackQueue.Enqueue(MoveTemp(Callback));
+        return true;
+    }
+
+    virtual bool IsInExecutorContext() const override
+    {
+        return IsInGameThread();
+    }
+
+    // -- END IGWTExecutor
+
+    // Limits the number of pending tick callbacks.
+    //
+    // Callbacks always execute on the game thread, thus the overflow
+    // policies are adapted as follows:
+    //  - Block on the game thread drains pending callbacks before enqueue,
+    //    other threads wait until the game thread drains the queue.
+    //  - RunInline executes the callback immediately on the game thread,
+    //    other threads block.
+    //  - DropOldest always enqueues, excess oldest callbacks are discarded
+    //    on the next drain.
+    void SetQueueLimit(int32 InCapacity, EGWTQueueOverflowPolicy InPolicy = EGWTQueueOverflowPolicy::Block)
+    {
+        check(InCapacity >= 0);
+        QueueCapacity = InCapacity;
+        OverflowPolicy = InPolicy;
+    }
+
+    FORCEINLINE int32 GetQueueCapacity() const
+    {
+        return QueueCapacity;
+    }
+
+    FORCEINLINE EGWTQueueOverflowPolicy GetQueueOverflowPolicy() const
+    {
+        return OverflowPolicy;
+    }
+
+    FORCEINLINE int32 GetQueueDepth() const
+    {
+        return FPlatformAtomics::AtomicRead(&QueueDepth);
+    }
+
+    FORCEINLINE int32 GetPeakQueueDepth() const
+    {
+        return FPlatformAtomics::AtomicRead(&PeakQueueDepth);
+    }
+
+    FORCEINLINE int32 GetRejectedCount() const
+    {
+        return RejectedCount.GetValue();
+    }
+
+    FORCEINLINE int32 GetDroppedCount() const
+    {
+        return DroppedCount.GetValue();
+    }
+
+    FORCEINLINE int32 GetInlineCount() const
+    {
+        return InlineCount.GetValue();
+    }
+
+    void ResetQueueStats()
+    {
+        FPlatformAtomics::InterlockedExchange(&PeakQueueDepth, GetQueueDepth());
+        RejectedCount.Reset();
+        DroppedCount.Reset();
+        InlineCount.Reset();
+    }
 };
@@ -33,6 +33,7 @@
 #include "GWTTickUtilities.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FGWTTickEvent_OnEventCallback);
+DECLARE_MULTICAST_DELEGATE(FGWTTickEvent_OnNativeEventCallback);
 
 UCLASS()
 class GENERICWORKERTHREAD_API UGWTTickUtilityLibrary : public UBlueprintFunctionLibrary
@@ -55,13 +56,57 @@ public:
 	UPROPERTY(BlueprintAssignable)
     FGWTTickEvent_OnEventCallback OnEventCallback;
 
+    // Native listeners, avoids reflection based dynamic delegate invocation
+    FGWTTickEvent_OnNativeEventCallback OnNativeEventCallback;
+
     FORCEINLINE void BroadcastEvent()
     {
-        OnEventCallback.Broadcast();
+        OnNativeEventCallback.Broadcast();
+
+        if (OnEventCallback.IsBound())
+        {
+            OnEventCallback.Broadcast();
+        }
     }
 
 	UFUNCTION(BlueprintCallable)
     void EnqueueCallback();
+
+    FORCEINLINE bool HasPendingCallback() const
+    {
+        return FPlatformAtomics::AtomicRead(&bIsDirty) != 0;
+    }
+
+    // Resets object for reuse, returns false if a callback is still queued
+    bool ResetPooledObject()
+    {
+        if (HasPendingCallback())
+        {
+            return false;
+        }
+
+        OnEventCallback.Clear();
+        OnNativeEventCallback.Clear();
+        return true;
+    }
+
+private:
+
+    friend class FGWTTickManager;
+
+    // Set while the event is queued to the tick manager
+    volatile int32 bIsDirty = 0;
+
+    // Returns true if the event was not dirty and needs to be queued
+    FORCEINLINE bool MarkDirty()
+    {
+        return FPlatformAtomics::InterlockedCompareExchange(&bIsDirty, 1, 0) == 0;
+    }
+
+    FORCEINLINE void ClearDirty()
+    {
+        FPlatformAtomics::InterlockedExchange(&bIsDirty, 0);
+    }
 };
 
 struct GENERICWORKERTHREAD_API FGWTTickEventRef
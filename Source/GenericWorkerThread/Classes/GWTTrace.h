@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformAtomics.h"
+
+// Compile-time switch, trace macros compile to nothing when disabled
+#ifndef GWT_TRACE_ENABLED
+#define GWT_TRACE_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+enum class EGWTTraceEventType : uint8
+{
+    Begin,
+    End,
+    Instant
+};
+
+enum class EGWTTraceOutput : uint8
+{
+    None     = 0,
+
+    // Record events to per-thread ring buffers, exportable as Chrome trace JSON
+    Buffer   = 1 << 0,
+
+    // Forward events to Unreal Insights CPU profiler channel, if available
+    Insights = 1 << 1,
+
+    All      = Buffer | Insights
+};
+
+ENUM_CLASS_FLAGS(EGWTTraceOutput);
+
+// Timeline tracing of task and worker execution.
+//
+// Each thread records events to its own fixed-size ring buffer, older events
+// are overwritten once the buffer is full. Event names are expected to be
+// static strings. Buffers should be exported after tracing has been stopped,
+// export while threads are still recording may read partially written events.
+class GENERICWORKERTHREAD_API FGWTTrace
+{
+    static volatile int32 OutputFlags;
+
+public:
+
+    FORCEINLINE static bool IsEnabled()
+    {
+        return OutputFlags != 0;
+    }
+
+    FORCEINLINE static EGWTTraceOutput GetOutput()
+    {
+        return static_cast<EGWTTraceOutput>(OutputFlags);
+    }
+
+    static void Start(EGWTTraceOutput Output = EGWTTraceOutput::Buffer);
+    static void Stop();
+
+    // Clears recorded events of all thread buffers. Buffers are cleared
+    // lazily by their owning thread on the next recorded event, buffers
+    // that have not recorded since the reset are skipped on export.
+    static void Reset();
+
+    static void Record(const TCHAR* Name, EGWTTraceEventType Type);
+
+    // Records event to the specified outputs regardless of the current outputs
+    static void Record(const TCHAR* Name, EGWTTraceEventType Type, EGWTTraceOutput Output);
+
+    // Writes recorded events as Chrome trace event format JSON,
+    // viewable in chrome://tracing or Perfetto
+    static bool ExportChromeTrace(const FString& FilePath);
+};
+
+// Outputs are latched on scope entry, the end event always goes to the same
+// outputs as the begin event even if tracing is started or stopped meanwhile
+struct FGWTTraceScope
+{
+    const EGWTTraceOutput Output;
+    const TCHAR* const Name;
+
+    FORCEINLINE FGWTTraceScope(const TCHAR* InName)
+        : Output(FGWTTrace::GetOutput())
+        , Name(Output != EGWTTraceOutput::None ? InName : nullptr)
+    {
+        if (Name)
+        {
+            FGWTTrace::Record(Name, EGWTTraceEventType::Begin, Output);
+        }
+    }
+
+    FORCEINLINE ~FGWTTraceScope()
+    {
+        if (Name)
+        {
+            FGWTTrace::Record(Name, EGWTTraceEventType::End, Output);
+        }
+    }
+};
+
+#if GWT_TRACE_ENABLED
+
+#define GWT_TRACE_SCOPE(Name) FGWTTraceScope PREPROCESSOR_JOIN(GWTTraceScope_, __LINE__)(TEXT(Name))
+#define GWT_TRACE_EVENT(Name) if (FGWTTrace::IsEnabled()) { FGWTTrace::Record(TEXT(Name), EGWTTraceEventType::Instant); }
+
+#else
+
+#define GWT_TRACE_SCOPE(Name)
+#define GWT_TRACE_EVENT(Name)
+
+#endif
@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Misc/Optional.h"
+#include "GWTTrace.h"
+
+typedef TSharedPtr<class IGWTTypedWorkerListBase, ESPMode::ThreadSafe> FPSGWTTypedWorkerList;
+
+// Worker list hosted by FGWTAsyncThread alongside its polymorphic worker
+// list. The hosting thread makes a single virtual call per list each loop,
+// workers within the list are ticked without virtual dispatch.
+class IGWTTypedWorkerListBase
+{
+public:
+
+    virtual ~IGWTTypedWorkerListBase() = default;
+
+    // Applies pending commands and ticks all workers, hosting thread only
+    virtual void TickWorkers(double CurrentTime) = 0;
+
+    // Destroys all workers, hosting thread only
+    virtual void ShutdownWorkers() = 0;
+
+    virtual int32 GetWorkerCount() const = 0;
+};
+
+// Worker list of a single concrete worker type. Workers are stored by value
+// in a contiguous array and ticked through a statically dispatched loop, the
+// worker tick call is qualified by the worker type so it is inlinable even if
+// the worker type declares a virtual Tick.
+//
+// WorkerType requires a Tick(float DeltaTime) member, move construction and
+// move assignment, as added workers are moved through TQueue and TOptional
+// command storage. Like any TArray element, workers are relocated bitwise
+// when the worker array grows or a worker is swap removed.
+//
+// Workers are set up by their constructor, which runs on the thread that
+// constructs the worker passed to AddWorker. Workers are shut down by their
+// destructor, which runs on the hosting thread for workers removed through
+// RemoveWorker or ShutdownWorkers, otherwise on whichever thread releases
+// the last reference to the list. Delta time is measured per list.
+//
+// Adding and removing workers is safe from any thread, commands are applied
+// at the start of the next list tick. Worker access is only safe on the
+// hosting thread, or on any thread before the list is hosted.
+template<typename WorkerType>
+class TGWTTypedWorkerList : public IGWTTypedWorkerListBase
+{
+public:
+
+    typedef TFunction<void(WorkerType&)> FWorkerCallback;
+
+    TGWTTypedWorkerList()
+        : LastTickTime(0.0)
+        , WorkerIdCounter(0)
+        , WorkerCount(0)
+    {
+    }
+
+    // Adds worker, returns worker id used for removal
+    int32 AddWorker(WorkerType&& Worker)
+    {
+        const int32 WorkerId = FPlatformAtomics::InterlockedIncrement(&WorkerIdCounter);
+
+        FCommand Command;
+        Command.WorkerId = WorkerId;
+        Command.Worker.Emplace(MoveTemp(Worker));
+        Commands.Enqueue(MoveTemp(Command));
+
+        return WorkerId;
+    }
+
+    void RemoveWorker(int32 WorkerId)
+    {
+        FCommand Command;
+        Command.WorkerId = WorkerId;
+        Commands.Enqueue(MoveTemp(Command));
+    }
+
+    // Executes callback on the worker during the next list tick,
+    // before the worker is ticked
+    void ModifyWorker(int32 WorkerId, FWorkerCallback Callback)
+    {
+        FCommand Command;
+        Command.WorkerId = WorkerId;
+        Command.Callback = MoveTemp(Callback);
+        Commands.Enqueue(MoveTemp(Command));
+    }
+
+    // Hosting thread only
+    FORCEINLINE WorkerType* FindWorker(int32 WorkerId)
+    {
+        const int32* WorkerIndex = WorkerIndexMap.Find(WorkerId);
+        return WorkerIndex ? &Workers[*WorkerIndex] : nullptr;
+    }
+
+    // Hosting thread only
+    FORCEINLINE TArrayView<WorkerType> GetWorkers()
+    {
+        return TArrayView<WorkerType>(Workers);
+    }
+
+    // -- BEGIN IGWTTypedWorkerListBase
+
+    virtual void TickWorkers(double CurrentTime) override
+    {
+        ProcessCommands();
+
+        const float DeltaTime = (LastTickTime > 0.0) ? static_cast<float>(CurrentTime - LastTickTime) : 0.f;
+        LastTickTime = CurrentTime;
+
+        GWT_TRACE_SCOPE("GWT.TypedWorkerList.Tick");
+
+        WorkerType* RESTRICT WorkerData = Workers.GetData();
+        const int32 Count = Workers.Num();
+
+        for (int32 i=0; i<Count; ++i)
+        {
+            WorkerData[i].WorkerType::Tick(DeltaTime);
+        }
+    }
+
+    virtual void ShutdownWorkers() override
+    {
+        ProcessCommands();
+
+        Workers.Empty();
+        WorkerIds.Empty();
+        WorkerIndexMap.Empty();
+        FPlatformAtomics::InterlockedExchange(&WorkerCount, 0);
+        LastTickTime = 0.0;
+    }
+
+    virtual int32 GetWorkerCount() const override
+    {
+        return FPlatformAtomics::AtomicRead(&WorkerCount);
+    }
+
+    // -- END IGWTTypedWorkerListBase
+
+private:
+
+    // Add command carries worker, remove command carries neither worker
+    // nor callback, modify command carries callback
+    struct FCommand
+    {
+        int32 WorkerId = 0;
+        TOptional<WorkerType> Worker;
+        FWorkerCallback Callback;
+    };
+
+    TArray<WorkerType> Workers;
+    TArray<int32> WorkerIds;
+    TMap<int32, int32> WorkerIndexMap;
+    double LastTickTime;
+
+    TQueue<FCommand, EQueueMode::Mpsc> Commands;
+    volatile int32 WorkerIdCounter;
+    volatile int32 WorkerCount;
+
+    void ProcessCommands()
+    {
+        FCommand Command;
+
+        while (Commands.Dequeue(Command))
+        {
+            if (Command.Worker.IsSet())
+            {
+                WorkerIndexMap.Emplace(Command.WorkerId, Workers.Num());
+                WorkerIds.Emplace(Command.WorkerId);
+                Workers.Emplace(MoveTemp(Command.Worker.GetValue()));
+            }
+            else if (Command.Callback)
+            {
+                if (WorkerType* Worker = FindWorker(Command.WorkerId))
+                {
+                    Command.Callback(*Worker);
+                }
+            }
+            else
+            {
+                RemoveWorkerAt(Command.WorkerId);
+            }
+
+            Command = FCommand();
+        }
+
+        FPlatformAtomics::InterlockedExchange(&WorkerCount, Workers.Num());
+    }
+
+    void RemoveWorkerAt(int32 WorkerId)
+    {
+        int32 WorkerIndex;
+
+        if (! WorkerIndexMap.RemoveAndCopyValue(WorkerId, WorkerIndex))
+        {
+            return;
+        }
+
+        const int32 LastIndex = Workers.Num()-1;
+
+        // Swap remove, update index of the moved worker
+        if (WorkerIndex != LastIndex)
+        {
+            WorkerIndexMap.FindChecked(WorkerIds[LastIndex]) = WorkerIndex;
+        }
+
+        Workers.RemoveAtSwap(WorkerIndex, 1, false);
+        WorkerIds.RemoveAtSwap(WorkerIndex, 1, false);
+    }
+};
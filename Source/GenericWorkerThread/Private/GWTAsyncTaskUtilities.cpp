@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "GWTAsyncTaskUtilities.h"
+#include "Engine/Engine.h"
+#include "LatentActions.h"
+#include "GenericWorkerThread.h"
+#include "GWTAsyncThreadManager.h"
+#include "GWTTickManager.h"
+
+namespace GWTAsyncTaskUtilities
+{
+    bool BindNamedThreadPool(FGWTAsyncTaskRef& TaskRef, FName PoolName, int32 ThreadCount)
+    {
+        if (PoolName.IsNone())
+        {
+            return true;
+        }
+
+        FGWTAsyncThreadManager& ThreadManager(IGenericWorkerThread::Get().GetAsyncThreadManager());
+        return TaskRef.SetThreadPool(ThreadManager.FindOrCreateNamedThreadPool(PoolName, ThreadCount));
+    }
+}
+
+class FGWTAsyncTaskLatentAction : public FPendingLatentAction
+{
+    typedef TSharedRef<EGWTAsyncTaskState, ESPMode::ThreadSafe> FCompletedState;
+
+    FName ExecutionFunction;
+    int32 OutputLink;
+    FWeakObjectPtr CallbackTarget;
+
+    FGWTAsyncTaskRef TaskRef;
+    EGWTAsyncTaskState& OutTaskState;
+
+    // Written by the tick manager done callback, idle until the task completes
+    FCompletedState CompletedState;
+    bool bIsEnqueued;
+
+public:
+
+    FGWTAsyncTaskLatentAction(
+        const FLatentActionInfo& LatentInfo,
+        const FGWTAsyncTaskRef& InTaskRef,
+        FName PoolName,
+        int32 ThreadCount,
+        EGWTAsyncTaskState& InOutTaskState
+        )
+        : ExecutionFunction(LatentInfo.ExecutionFunction)
+        , OutputLink(LatentInfo.Linkage)
+        , CallbackTarget(LatentInfo.CallbackTarget)
+        , TaskRef(InTaskRef)
+        , OutTaskState(InOutTaskState)
+        , CompletedState(MakeShared<EGWTAsyncTaskState, ESPMode::ThreadSafe>(EGWTAsyncTaskState::Idle))
+        , bIsEnqueued(false)
+    {
+        if (GWTAsyncTaskUtilities::BindNamedThreadPool(TaskRef, PoolName, ThreadCount))
+        {
+            FCompletedState TaskCompletedState(CompletedState);
+
+            bIsEnqueued = TaskRef.EnqueueTask(
+                [TaskCompletedState](EGWTAsyncTaskState TaskState)
+                {
+                    *TaskCompletedState = TaskState;
+                } );
+        }
+    }
+
+    virtual void UpdateOperation(FLatentResponse& Response) override
+    {
+        const EGWTAsyncTaskState TaskState = *CompletedState;
+        const bool bIsCompleted = ! bIsEnqueued || TaskState != EGWTAsyncTaskState::Idle;
+
+        if (bIsCompleted)
+        {
+            OutTaskState = bIsEnqueued ? TaskState : TaskRef.GetState();
+        }
+
+        Response.FinishAndTriggerIf(bIsCompleted, ExecutionFunction, OutputLink, CallbackTarget);
+    }
+
+    virtual void NotifyObjectDestroyed() override
+    {
+        TaskRef.Cancel();
+    }
+
+    virtual void NotifyActionAborted() override
+    {
+        TaskRef.Cancel();
+    }
+
+#if WITH_EDITOR
+    virtual FString GetDescription() const override
+    {
+        return FString::Printf(TEXT("Async Task (%s)"), *UEnum::GetValueAsString(TaskRef.GetState()));
+    }
+#endif
+};
+
+void UGWTAsyncTaskUtilityLibrary::ExecuteTaskLatent(
+    UObject* WorldContextObject,
+    FLatentActionInfo LatentInfo,
+    FGWTAsyncTaskRef& TaskRef,
+    FName PoolName,
+    EGWTAsyncTaskState& OutTaskState,
+    int32 ThreadCount
+    )
+{
+    UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+
+    if (! World)
+    {
+        return;
+    }
+
+    FLatentActionManager& LatentActionManager(World->GetLatentActionManager());
+
+    // Latent action already in progress, skip
+    if (LatentActionManager.FindExistingAction<FGWTAsyncTaskLatentAction>(LatentInfo.CallbackTarget, LatentInfo.UUID))
+    {
+        return;
+    }
+
+    LatentActionManager.AddNewAction(
+        LatentInfo.CallbackTarget,
+        LatentInfo.UUID,
+        new FGWTAsyncTaskLatentAction(LatentInfo, TaskRef, PoolName, ThreadCount, OutTaskState)
+        );
+}
+
+UGWTAsyncTaskAction* UGWTAsyncTaskAction::ExecuteAsyncTask(
+    UObject* WorldContextObject,
+    const FGWTAsyncTaskRef& TaskRef,
+    FName PoolName,
+    int32 ThreadCount
+    )
+{
+    UGWTAsyncTaskAction* Action = NewObject<UGWTAsyncTaskAction>();
+    Action->TaskRef = TaskRef;
+    Action->PoolName = PoolName;
+    Action->ThreadCount = ThreadCount;
+    Action->RegisterWithGameInstance(WorldContextObject);
+    return Action;
+}
+
+void UGWTAsyncTaskAction::Activate()
+{
+    TWeakObjectPtr<UGWTAsyncTaskAction> Action(this);
+
+    const bool bIsEnqueued = GWTAsyncTaskUtilities::BindNamedThreadPool(TaskRef, PoolName, ThreadCount)
+        && TaskRef.EnqueueTask(
+            [Action](EGWTAsyncTaskState TaskState)
+            {
+                if (Action.IsValid())
+                {
+                    Action->BroadcastTaskState(TaskState);
+                }
+            } );
+
+    // Failed enqueue is reported on the next tick as well, keeping completion
+    // pins out of the node activation call. Deferred callbacks are not subject
+    // to the callback queue limit.
+    if (! bIsEnqueued)
+    {
+        if (IGenericWorkerThread::IsAvailable())
+        {
+            FGWTTickManager& TickManager(IGenericWorkerThread::Get().GetTickManager());
+            TickManager.Defer(
+                [Action]()
+                {
+                    if (Action.IsValid())
+                    {
+                        Action->OnTaskFailed.Broadcast();
+                        Action->SetReadyToDestroy();
+                    }
+                } );
+        }
+        else
+        {
+            OnTaskFailed.Broadcast();
+            SetReadyToDestroy();
+        }
+    }
+}
+
+void UGWTAsyncTaskAction::BroadcastTaskState(EGWTAsyncTaskState TaskState)
+{
+    if (TaskState == EGWTAsyncTaskState::Cancelled)
+    {
+        OnTaskCancelled.Broadcast();
+    }
+    else
+    {
+        OnTaskDone.Broadcast();
+    }
+
+    SetReadyToDestroy();
+}
@@ -28,6 +28,9 @@
 #pragma once
 
 #include "GWTAsyncThreadManager.h"
+#include "Containers/Ticker.h"
+#include "GenericWorkerThread.h"
+#include "GWTTickManager.h"
 
 FPSGWTAsyncThread FGWTAsyncThreadWeakInstance::Pin(class FGWTAsyncThreadManager& ThreadManager)
 {
@@ -53,6 +56,14 @@ FPSGWTAsyncThreadPool FGWTAsyncThreadPoolWeakInstance::Pin(class FGWTAsyncThread
     return AsyncThreadPoolPtr.Pin();
 }
 
+FGWTAsyncThreadManager::~FGWTAsyncThreadManager()
+{
+    DisableLoadBalancing();
+    DisableWatchdog();
+
+    IsolationThreads.Empty();
+}
+
 // Thread Functions
 
 FPSGWTAsyncThread FGWTAsyncThreadManager::CreateThread(float InRestTime, int32& OutInstanceId)
@@ -60,6 +71,26 @@ FPSGWTAsyncThread FGWTAsyncThreadManager::CreateThread(float InRestTime, int32&
     int32 InstanceId = ThreadRegister.UniqueID++;
     FPSGWTAsyncThread AsyncThread( new FGWTAsyncThread(InRestTime) );
     ThreadRegister.InstanceMap.Emplace(InstanceId, AsyncThread);
+
+    // Isolated workers are moved to their own thread on the game thread,
+    // deferred callbacks are not subject to the tick manager queue limit
+    FPWGWTAsyncThread pSourceThread(AsyncThread);
+
+    AsyncThread->SetIsolateWorkerCallback(
+        [this, pSourceThread](FGWTAsyncThread& SourceThread, const FPSGWTTaskWorker& Worker)
+        {
+            if (IGenericWorkerThread::IsAvailable())
+            {
+                FPWGWTTaskWorker pWorker(Worker);
+
+                IGenericWorkerThread::Get().GetTickManager().Defer(
+                    [this, pWorker, pSourceThread]()
+                    {
+                        IsolateWorker(pWorker, pSourceThread);
+                    } );
+            }
+        } );
+
     OutInstanceId = InstanceId;
     return MoveTemp( AsyncThread );
 }
@@ -77,6 +108,210 @@ FPWGWTAsyncThread FGWTAsyncThreadManager::GetThread(int32 InstanceId) const
         : FPWGWTAsyncThread();
 }
 
+// Load Balancing
+
+void FGWTAsyncThreadManager::EnableLoadBalancing(double TargetLoopTime, float BalanceInterval)
+{
+    check(IsInGameThread());
+
+    DisableLoadBalancing();
+
+    BalanceTargetLoopTime = FMath::Max(TargetLoopTime, 0.0);
+    BalanceTickerHandle = FTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FGWTAsyncThreadManager::TickLoadBalancing),
+        FMath::Max(BalanceInterval, 0.f)
+        );
+}
+
+void FGWTAsyncThreadManager::DisableLoadBalancing()
+{
+    if (BalanceTickerHandle.IsValid())
+    {
+        FTicker::GetCoreTicker().RemoveTicker(BalanceTickerHandle);
+        BalanceTickerHandle.Reset();
+    }
+}
+
+bool FGWTAsyncThreadManager::TickLoadBalancing(float DeltaTime)
+{
+    BalanceThreads(BalanceTargetLoopTime);
+    return true;
+}
+
+bool FGWTAsyncThreadManager::BalanceThreads(double TargetLoopTime)
+{
+    check(IsInGameThread());
+
+    FPSGWTAsyncThread BusiestThread;
+    FPSGWTAsyncThread IdlestThread;
+    double BusiestLoopTime = 0.0;
+    double IdlestLoopTime = 0.0;
+
+    for (const TPair<int32, FPWGWTAsyncThread>& ThreadPair : ThreadRegister.InstanceMap)
+    {
+        FPSGWTAsyncThread AsyncThread( ThreadPair.Value.Pin() );
+
+        if (! AsyncThread.IsValid() || ! AsyncThread->IsThreadStarted() || AsyncThread->IsThreadStopped())
+        {
+            continue;
+        }
+
+        // Isolation threads are reserved to their isolated worker
+        const bool bIsIsolationThread = IsolationThreads.ContainsByPredicate(
+            [&AsyncThread](const FIsolationThread& IsolationThread)
+            {
+                return IsolationThread.AsyncThread == AsyncThread;
+            } );
+
+        if (bIsIsolationThread || AsyncThread->IsExcludedFromBalancing())
+        {
+            continue;
+        }
+
+        const double LoopTime = AsyncThread->GetAverageLoopTime();
+
+        if (! BusiestThread.IsValid() || LoopTime > BusiestLoopTime)
+        {
+            BusiestThread = AsyncThread;
+            BusiestLoopTime = LoopTime;
+        }
+
+        if (! IdlestThread.IsValid() || LoopTime < IdlestLoopTime)
+        {
+            IdlestThread = AsyncThread;
+            IdlestLoopTime = LoopTime;
+        }
+    }
+
+    if (! BusiestThread.IsValid() || BusiestThread == IdlestThread || BusiestLoopTime <= TargetLoopTime)
+    {
+        return false;
+    }
+
+    // Move at most half of the load difference to avoid migrating
+    // the overload to the target thread
+
+    const double MigrationCost = FMath::Min(
+        BusiestLoopTime - TargetLoopTime,
+        (BusiestLoopTime - IdlestLoopTime) * 0.5
+        );
+
+    if (MigrationCost <= 0.0)
+    {
+        return false;
+    }
+
+    BusiestThread->MigrateWorkers(MigrationCost, IdlestThread);
+
+    return true;
+}
+
+// Worker Isolation
+
+void FGWTAsyncThreadManager::IsolateWorker(const FPWGWTTaskWorker& Worker, const FPWGWTAsyncThread& pSourceThread)
+{
+    check(IsInGameThread());
+
+    PruneIsolationThreads();
+
+    FPSGWTAsyncThread SourceThread(pSourceThread.Pin());
+
+    if (! Worker.IsValid() || ! SourceThread.IsValid())
+    {
+        return;
+    }
+
+    FIsolationThread IsolationThread;
+    IsolationThread.AsyncThread = CreateThread(SourceThread->GetRestTime());
+    IsolationThread.AdoptLatch = MakeUnique<FGWTWorkerLatch>();
+
+    // Isolated workers that keep overrunning are demoted instead
+    IsolationThread.AsyncThread->SetIsolateWorkerCallback(FGWTAsyncThread::FIsolateWorkerCallback());
+    IsolationThread.AsyncThread->StartThread();
+
+    // Worker stays on the source thread until the handoff is issued,
+    // workers removed in the meantime leave the isolation thread empty
+    SourceThread->MigrateWorker(Worker, IsolationThread.AsyncThread, IsolationThread.AdoptLatch.Get());
+
+    IsolationThreads.Emplace(MoveTemp(IsolationThread));
+}
+
+void FGWTAsyncThreadManager::PruneIsolationThreads()
+{
+    // Remove isolation threads whose worker has been removed or expired
+    IsolationThreads.RemoveAll(
+        [](const FIsolationThread& IsolationThread)
+        {
+            return IsolationThread.AdoptLatch->IsDone()
+                && IsolationThread.AsyncThread->GetWorkerCount() == 0;
+        } );
+}
+
+// Watchdog
+
+void FGWTAsyncThreadManager::EnableWatchdog(float StallFactor, float CheckInterval, double MinStallTime)
+{
+    check(IsInGameThread());
+
+    DisableWatchdog();
+
+    WatchdogStallFactor = FMath::Max(StallFactor, 1.f);
+    WatchdogMinStallTime = FMath::Max(MinStallTime, 0.0);
+    WatchdogTickerHandle = FTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FGWTAsyncThreadManager::TickWatchdog),
+        FMath::Max(CheckInterval, 0.f)
+        );
+}
+
+void FGWTAsyncThreadManager::DisableWatchdog()
+{
+    if (WatchdogTickerHandle.IsValid())
+    {
+        FTicker::GetCoreTicker().RemoveTicker(WatchdogTickerHandle);
+        WatchdogTickerHandle.Reset();
+    }
+
+    StalledThreads.Empty();
+}
+
+bool FGWTAsyncThreadManager::TickWatchdog(float DeltaTime)
+{
+    PruneIsolationThreads();
+
+    for (const TPair<int32, FPWGWTAsyncThread>& ThreadPair : ThreadRegister.InstanceMap)
+    {
+        FPSGWTAsyncThread AsyncThread( ThreadPair.Value.Pin() );
+
+        if (! AsyncThread.IsValid() || ! AsyncThread->IsThreadStarted())
+        {
+            StalledThreads.Remove(ThreadPair.Key);
+            continue;
+        }
+
+        const double ExpectedPeriod = AsyncThread->GetRestTime() + AsyncThread->GetAverageLoopTime();
+        const double StallTime = FMath::Max(ExpectedPeriod * WatchdogStallFactor, WatchdogMinStallTime);
+        const double TickTime = AsyncThread->GetCurrentTickTime();
+
+        if (TickTime > StallTime)
+        {
+            bool bIsAlreadyStalled = false;
+            StalledThreads.Add(ThreadPair.Key, &bIsAlreadyStalled);
+
+            UE_CLOG(! bIsAlreadyStalled, LogGWT, Warning, TEXT("FGWTAsyncThreadManager::TickWatchdog() - Thread %d loop stalled for %.2f ms (expected %.2f ms), last ticking worker %d"),
+                ThreadPair.Key,
+                TickTime * 1000.0,
+                ExpectedPeriod * 1000.0,
+                AsyncThread->GetTickingWorkerId());
+        }
+        else
+        {
+            StalledThreads.Remove(ThreadPair.Key);
+        }
+    }
+
+    return true;
+}
+
 // Thread Pool Functions
 
 FPSGWTAsyncThreadPool FGWTAsyncThreadManager::CreateThreadPool(int32 ThreadCount, int32& OutInstanceId)
@@ -100,3 +335,35 @@ FPWGWTAsyncThreadPool FGWTAsyncThreadManager::GetThreadPool(int32 InstanceId) co
         ? ThreadPoolRegister.InstanceMap.FindChecked(InstanceId)
         : FPWGWTAsyncThreadPool();
 }
+
+FPSGWTAsyncThreadPool FGWTAsyncThreadManager::FindOrCreateNamedThreadPool(FName PoolName, int32 ThreadCount)
+{
+    check(IsInGameThread());
+
+    if (PoolName.IsNone())
+    {
+        return nullptr;
+    }
+
+    if (const FPSGWTAsyncThreadPool* NamedThreadPool = ThreadPoolRegister.NamedInstanceMap.Find(PoolName))
+    {
+        return *NamedThreadPool;
+    }
+
+    FPSGWTAsyncThreadPool AsyncThreadPool(CreateThreadPool(FMath::Max(ThreadCount, 1)));
+    ThreadPoolRegister.NamedInstanceMap.Emplace(PoolName, AsyncThreadPool);
+    return MoveTemp( AsyncThreadPool );
+}
+
+FPSGWTAsyncThreadPool FGWTAsyncThreadManager::GetNamedThreadPool(FName PoolName) const
+{
+    return ThreadPoolRegister.NamedInstanceMap.Contains(PoolName)
+        ? ThreadPoolRegister.NamedInstanceMap.FindChecked(PoolName)
+        : FPSGWTAsyncThreadPool();
+}
+
+bool FGWTAsyncThreadManager::RemoveNamedThreadPool(FName PoolName)
+{
+    check(IsInGameThread());
+    return ThreadPoolRegister.NamedInstanceMap.Remove(PoolName) > 0;
+}
@@ -0,0 +1,815 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "GWTAsyncThreadPool.h"
+#include "HAL/Event.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "GenericWorkerThread.h"
+#include "GWTTickManager.h"
+
+// Thread Pool Worker Thread
+
+class FGWTAsyncThreadPool::FWorkerThread : public FRunnable
+{
+    FGWTAsyncThreadPool& ThreadPool;
+    FRunnableThread* Thread;
+
+public:
+
+    FEvent* WakeEvent;
+
+    FWorkerThread(FGWTAsyncThreadPool& InThreadPool, int32 InThreadIndex, uint32 InStackSize)
+        : ThreadPool(InThreadPool)
+        , Thread(nullptr)
+        , WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+    {
+        const FString ThreadName(FString::Printf(TEXT("GWTAsyncThreadPool Worker %d"), InThreadIndex));
+        Thread = FRunnableThread::Create(this, *ThreadName, InStackSize, TPri_Normal);
+        check(Thread != nullptr);
+    }
+
+    virtual ~FWorkerThread()
+    {
+        // Thread pool is expected to have requested stop
+        WakeEvent->Trigger();
+        Thread->WaitForCompletion();
+        delete Thread;
+
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    }
+
+    virtual uint32 Run() override
+    {
+        ThreadPool.ExecuteWorkerThread(*this);
+        return 0;
+    }
+};
+
+// Scheduled Work
+
+class FGWTAsyncThreadPool::FScheduledWork : public IQueuedWork
+{
+    TFunction<void()> Function;
+    TPromise<bool> Promise;
+
+public:
+
+    FScheduledWork(TFunction<void()>&& InFunction, TPromise<bool>&& InPromise)
+        : Function(MoveTemp(InFunction))
+        , Promise(MoveTemp(InPromise))
+    {
+    }
+
+    virtual void DoThreadedWork() override
+    {
+        Function();
+        Promise.SetValue(true);
+        delete this;
+    }
+
+    virtual void Abandon() override
+    {
+        Promise.SetValue(false);
+        delete this;
+    }
+};
+
+// Executor Work
+
+class FGWTAsyncThreadPool::FExecutorWork : public IQueuedWork
+{
+    FExecutorCallback Callback;
+
+public:
+
+    FExecutorWork(FExecutorCallback&& InCallback)
+        : Callback(MoveTemp(InCallback))
+    {
+    }
+
+    virtual void DoThreadedWork() override
+    {
+        if (Callback)
+        {
+            Callback();
+        }
+
+        delete this;
+    }
+
+    virtual void Abandon() override
+    {
+        delete this;
+    }
+};
+
+// Thread Pool
+
+FGWTAsyncThreadPool::FGWTAsyncThreadPool()
+    : bThreadPoolCreated(false)
+    , QueueSequence(0)
+    , DelayedWorkCount(0)
+    , QueuedWorkCount(0)
+    , SpinningThreadCount(0)
+    , bIsStopping(false)
+    , DeadlinePolicy(EGWTDeadlinePolicy::Shed)
+    , QueueCapacity(0)
+    , OverflowPolicy(EGWTQueueOverflowPolicy::Block)
+    , AverageWorkTimeUsec(0)
+    , PeakQueueDepth(0)
+{
+}
+
+FGWTAsyncThreadPool::FGWTAsyncThreadPool(int32 InThreadCount)
+    : bThreadPoolCreated(false)
+    , QueueSequence(0)
+    , DelayedWorkCount(0)
+    , QueuedWorkCount(0)
+    , SpinningThreadCount(0)
+    , bIsStopping(false)
+    , DeadlinePolicy(EGWTDeadlinePolicy::Shed)
+    , QueueCapacity(0)
+    , OverflowPolicy(EGWTQueueOverflowPolicy::Block)
+    , AverageWorkTimeUsec(0)
+    , PeakQueueDepth(0)
+{
+    SetThreadInstanceCount(InThreadCount);
+}
+
+FGWTAsyncThreadPool::~FGWTAsyncThreadPool()
+{
+    DestroyThreads();
+
+    // Abandon remaining queued work
+    FScopeLock QueueScopeLock(&QueueLock);
+
+    for (FQueuedEntry& Entry : QueuedWork)
+    {
+        Entry.Work->Abandon();
+    }
+
+    QueuedWork.Empty();
+    QueuedWorkCount = 0;
+
+    for (FDelayedEntry& Entry : DelayedWork)
+    {
+        Entry.Work->Abandon();
+    }
+
+    DelayedWork.Empty();
+    DelayedWorkCount = 0;
+}
+
+void FGWTAsyncThreadPool::SetThreadInstanceCount(int32 InThreadCount)
+{
+    if (bThreadPoolCreated)
+    {
+        DestroyThreads();
+    }
+
+    CreateThreads(InThreadCount);
+}
+
+void FGWTAsyncThreadPool::CreateThreads(int32 InThreadCount)
+{
+    check(WorkerThreads.Num() == 0);
+
+    bIsStopping = false;
+
+    for (int32 i=0; i<InThreadCount; ++i)
+    {
+        WorkerThreads.Emplace(new FWorkerThread(*this, i, 32 * 1024));
+    }
+
+    bThreadPoolCreated = WorkerThreads.Num() > 0;
+}
+
+void FGWTAsyncThreadPool::DestroyThreads()
+{
+    bIsStopping = true;
+
+    {
+        FScopeLock QueueScopeLock(&QueueLock);
+        ParkedThreads.Reset();
+    }
+
+    for (FWorkerThread* WorkerThread : WorkerThreads)
+    {
+        delete WorkerThread;
+    }
+
+    WorkerThreads.Reset();
+    bThreadPoolCreated = false;
+}
+
+FGWTAsyncThreadPool::FQueuedEntry FGWTAsyncThreadPool::MakeEntry(IQueuedWork* Work, const FGWTTaskSchedule& Schedule)
+{
+    FQueuedEntry Entry;
+    Entry.Work = Work;
+    Entry.Sequence = QueueSequence++;
+    Entry.Deadline = Schedule.HasDeadline() ? Schedule.Deadline : TNumericLimits<double>::Max();
+    Entry.EnqueueTime = FPlatformTime::Seconds();
+    Entry.Priority = Schedule.Priority;
+    Entry.bOptional = Schedule.bOptional;
+    return Entry;
+}
+
+void FGWTAsyncThreadPool::PushEntry(const FQueuedEntry& Entry)
+{
+    QueuedWork.HeapPush(Entry);
+
+    const int32 QueueDepth = FPlatformAtomics::InterlockedIncrement(&QueuedWorkCount);
+
+    if (QueueDepth > PeakQueueDepth)
+    {
+        FPlatformAtomics::InterlockedExchange(&PeakQueueDepth, QueueDepth);
+    }
+}
+
+IQueuedWork* FGWTAsyncThreadPool::PopOldestEntry()
+{
+    check(QueuedWork.Num() > 0);
+
+    int32 OldestIndex = 0;
+
+    for (int32 i=1; i<QueuedWork.Num(); ++i)
+    {
+        if (QueuedWork[i].Sequence < QueuedWork[OldestIndex].Sequence)
+        {
+            OldestIndex = i;
+        }
+    }
+
+    IQueuedWork* Work = QueuedWork[OldestIndex].Work;
+
+    QueuedWork.RemoveAtSwap(OldestIndex, 1, false);
+    QueuedWork.Heapify();
+    FPlatformAtomics::InterlockedDecrement(&QueuedWorkCount);
+
+    return Work;
+}
+
+void FGWTAsyncThreadPool::WaitForQueueCapacity()
+{
+    const bool bIsWorkerThread = IGWTWaitHelper::GetCurrent() == this;
+
+    while (QueueCapacity > 0 && GetQueueDepth() >= QueueCapacity && ! bIsStopping)
+    {
+        if (! bIsWorkerThread || ! TryExecuteQueuedWork())
+        {
+            FPlatformProcess::SleepNoStats(0.f);
+        }
+    }
+}
+
+bool FGWTAsyncThreadPool::AddQueuedWork(IQueuedWork* Work, const FGWTTaskSchedule& Schedule)
+{
+    check(Work != nullptr);
+
+    if (! bThreadPoolCreated)
+    {
+        return false;
+    }
+
+    GWT_TRACE_EVENT("GWT.Pool.Enqueue");
+
+    FWakeThreadList WakeThreadList;
+    IQueuedWork* DroppedWork = nullptr;
+
+    for (;;)
+    {
+        EGWTQueueOverflowPolicy QueueOverflowPolicy;
+
+        {
+            FScopeLock QueueScopeLock(&QueueLock);
+
+            QueueOverflowPolicy = OverflowPolicy;
+
+            const bool bIsFull = QueueCapacity > 0 && QueuedWork.Num() >= QueueCapacity;
+
+            if (! bIsFull || QueueOverflowPolicy == EGWTQueueOverflowPolicy::DropOldest)
+            {
+                if (bIsFull)
+                {
+                    DroppedWork = PopOldestEntry();
+                    DroppedCount.Increment();
+                }
+
+                PushEntry(MakeEntry(Work, Schedule));
+                PopParkedThreads(1, WakeThreadList);
+                break;
+            }
+        }
+
+        // Queue is full
+
+        if (QueueOverflowPolicy == EGWTQueueOverflowPolicy::Reject)
+        {
+            RejectedCount.Increment();
+            return false;
+        }
+        else if (QueueOverflowPolicy == EGWTQueueOverflowPolicy::RunInline)
+        {
+            InlineCount.Increment();
+            Work->DoThreadedWork();
+            return true;
+        }
+
+        WaitForQueueCapacity();
+    }
+
+    WakeThreads(WakeThreadList);
+
+    if (DroppedWork)
+    {
+        DroppedWork->Abandon();
+    }
+
+    return true;
+}
+
+bool FGWTAsyncThreadPool::AddQueuedWorkBatch(const TArray<IQueuedWork*>& WorkBatch, const FGWTTaskSchedule& Schedule)
+{
+    if (! bThreadPoolCreated)
+    {
+        return false;
+    }
+
+    if (WorkBatch.Num() == 0)
+    {
+        return true;
+    }
+
+    GWT_TRACE_EVENT("GWT.Pool.EnqueueBatch");
+
+    TArray<IQueuedWork*, TInlineAllocator<8>> DroppedWork;
+    int32 QueuedIndex = 0;
+
+    while (QueuedIndex < WorkBatch.Num())
+    {
+        FWakeThreadList WakeThreadList;
+        EGWTQueueOverflowPolicy QueueOverflowPolicy;
+
+        {
+            FScopeLock QueueScopeLock(&QueueLock);
+
+            QueueOverflowPolicy = OverflowPolicy;
+
+            // Rejected batches are rejected as a whole
+            if (QueueOverflowPolicy == EGWTQueueOverflowPolicy::Reject
+                && QueueCapacity > 0
+                && (QueuedWork.Num() + WorkBatch.Num()) > QueueCapacity)
+            {
+                RejectedCount.Add(WorkBatch.Num());
+                return false;
+            }
+
+            const int32 FirstIndex = QueuedIndex;
+
+            QueuedWork.Reserve(QueuedWork.Num() + WorkBatch.Num() - QueuedIndex);
+
+            while (QueuedIndex < WorkBatch.Num())
+            {
+                check(WorkBatch[QueuedIndex] != nullptr);
+
+                const bool bIsFull = QueueCapacity > 0 && QueuedWork.Num() >= QueueCapacity;
+
+                if (bIsFull)
+                {
+                    if (QueueOverflowPolicy != EGWTQueueOverflowPolicy::DropOldest)
+                    {
+                        break;
+                    }
+
+                    DroppedWork.Emplace(PopOldestEntry());
+                    DroppedCount.Increment();
+                }
+
+                PushEntry(MakeEntry(WorkBatch[QueuedIndex], Schedule));
+                ++QueuedIndex;
+            }
+
+            PopParkedThreads(QueuedIndex - FirstIndex, WakeThreadList);
+        }
+
+        WakeThreads(WakeThreadList);
+
+        // Queue is full, handle remaining work
+
+        if (QueuedIndex < WorkBatch.Num())
+        {
+            if (QueueOverflowPolicy == EGWTQueueOverflowPolicy::RunInline)
+            {
+                for (; QueuedIndex < WorkBatch.Num(); ++QueuedIndex)
+                {
+                    InlineCount.Increment();
+                    WorkBatch[QueuedIndex]->DoThreadedWork();
+                }
+            }
+            else
+            {
+                WaitForQueueCapacity();
+            }
+        }
+    }
+
+    for (IQueuedWork* Work : DroppedWork)
+    {
+        Work->Abandon();
+    }
+
+    return true;
+}
+
+void FGWTAsyncThreadPool::PopParkedThreads(int32 WorkCount, FWakeThreadList& OutWakeThreads)
+{
+    // Spinning worker threads pick up work without being woken
+    const int32 WakeCount = WorkCount - FPlatformAtomics::AtomicRead(&SpinningThreadCount);
+    const int32 ParkedCount = FMath::Min(WakeCount, ParkedThreads.Num());
+
+    for (int32 i=0; i<ParkedCount; ++i)
+    {
+        OutWakeThreads.Emplace(ParkedThreads.Pop(false));
+    }
+}
+
+void FGWTAsyncThreadPool::WakeThreads(const FWakeThreadList& InWakeThreads)
+{
+    for (FWorkerThread* WakeThread : InWakeThreads)
+    {
+        WakeThread->WakeEvent->Trigger();
+    }
+}
+
+bool FGWTAsyncThreadPool::AddDelayedWork(IQueuedWork* Work, double Delay, const FGWTTaskSchedule& Schedule)
+{
+    check(Work != nullptr);
+
+    if (Delay <= 0.0)
+    {
+        return AddQueuedWork(Work, Schedule);
+    }
+
+    if (! bThreadPoolCreated)
+    {
+        return false;
+    }
+
+    FWakeThreadList WakeThreadList;
+
+    {
+        FScopeLock QueueScopeLock(&QueueLock);
+
+        FDelayedEntry Entry;
+        Entry.Work = Work;
+        Entry.IssueTime = FPlatformTime::Seconds() + Delay;
+        Entry.Schedule = Schedule;
+
+        DelayedWork.HeapPush(Entry);
+        FPlatformAtomics::InterlockedIncrement(&DelayedWorkCount);
+
+        // Wake a parked worker thread to wait for the new earliest issue time
+        if (DelayedWork.HeapTop().Work == Work && ParkedThreads.Num() > 0)
+        {
+            WakeThreadList.Emplace(ParkedThreads.Pop(false));
+        }
+    }
+
+    WakeThreads(WakeThreadList);
+
+    return true;
+}
+
+int32 FGWTAsyncThreadPool::PromoteDelayedWork(double CurrentTime)
+{
+    int32 PromotedCount = 0;
+
+    while (DelayedWork.Num() > 0 && DelayedWork.HeapTop().IssueTime <= CurrentTime)
+    {
+        FDelayedEntry Entry;
+        DelayedWork.HeapPop(Entry, false);
+        FPlatformAtomics::InterlockedDecrement(&DelayedWorkCount);
+
+        PushEntry(MakeEntry(Entry.Work, Entry.Schedule));
+        ++PromotedCount;
+    }
+
+    return PromotedCount;
+}
+
+TFuture<bool> FGWTAsyncThreadPool::AddScheduledWork(TFunction<void()> Function, const FGWTTaskSchedule& Schedule, TFunction<void()> CompletionCallback)
+{
+    if (! bThreadPoolCreated)
+    {
+        return TFuture<bool>();
+    }
+
+    TPromise<bool> Promise(MoveTemp(CompletionCallback));
+    TFuture<bool> Future(Promise.GetFuture());
+
+    AddQueuedWork(new FScheduledWork(MoveTemp(Function), MoveTemp(Promise)), Schedule);
+
+    return Future;
+}
+
+bool FGWTAsyncThreadPool::DequeueWork(FQueuedEntry& OutEntry)
+{
+    if (! HasQueuedWork() && GetDelayedWorkCount() == 0)
+    {
+        return false;
+    }
+
+    TArray<IQueuedWork*, TInlineAllocator<8>> ShedWork;
+    FWakeThreadList WakeThreadList;
+    bool bHasEntry = false;
+
+    {
+        FScopeLock QueueScopeLock(&QueueLock);
+
+        const double CurrentTime = FPlatformTime::Seconds();
+        const double ExpectedFinishTime = CurrentTime + GetAverageWorkTime();
+
+        // Promote due delayed work, one of the promoted work is
+        // picked up by this thread, wake parked threads for the rest
+        const int32 PromotedCount = PromoteDelayedWork(CurrentTime);
+
+        if (PromotedCount > 1)
+        {
+            PopParkedThreads(PromotedCount-1, WakeThreadList);
+        }
+
+        while (QueuedWork.Num() > 0)
+        {
+            QueuedWork.HeapPop(OutEntry, false);
+
+            // Optional work unable to meet its deadline
+            if (OutEntry.bOptional
+                && OutEntry.Deadline < ExpectedFinishTime
+                && DeadlinePolicy != EGWTDeadlinePolicy::Keep)
+            {
+                if (DeadlinePolicy == EGWTDeadlinePolicy::Shed)
+                {
+                    FPlatformAtomics::InterlockedDecrement(&QueuedWorkCount);
+                    ShedWork.Emplace(OutEntry.Work);
+                    ShedCount.Increment();
+                }
+                else
+                {
+                    OutEntry.Priority = EGWTTaskPriority::Low;
+                    OutEntry.Deadline = TNumericLimits<double>::Max();
+                    OutEntry.bOptional = false;
+                    QueuedWork.HeapPush(OutEntry);
+                    DowngradeCount.Increment();
+                }
+
+                continue;
+            }
+
+            FPlatformAtomics::InterlockedDecrement(&QueuedWorkCount);
+            bHasEntry = true;
+            break;
+        }
+    }
+
+    WakeThreads(WakeThreadList);
+
+    for (IQueuedWork* Work : ShedWork)
+    {
+        Work->Abandon();
+    }
+
+    return bHasEntry;
+}
+
+bool FGWTAsyncThreadPool::TryExecuteQueuedWork()
+{
+    FQueuedEntry Entry;
+
+    if (! DequeueWork(Entry))
+    {
+        return false;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    {
+        GWT_TRACE_SCOPE("GWT.Pool.Task");
+        Entry.Work->DoThreadedWork();
+    }
+
+    const double FinishTime = FPlatformTime::Seconds();
+
+    if (Entry.Deadline < FinishTime)
+    {
+        DeadlineMissCount.Increment();
+    }
+
+    CompletedWorkCount.Increment();
+    LatencyHistogram.AddSeconds(FinishTime - Entry.EnqueueTime);
+
+    // Exponential moving average of work execution time
+    const int32 WorkTimeUsec = FMath::Min(FMath::RoundToInt((FinishTime - StartTime) * 1e6), MAX_int32 / 2);
+    const int32 AverageUsec = FPlatformAtomics::AtomicRead(&AverageWorkTimeUsec);
+    FPlatformAtomics::InterlockedExchange(&AverageWorkTimeUsec, AverageUsec + (WorkTimeUsec - AverageUsec) / 8);
+
+    return true;
+}
+
+void FGWTAsyncThreadPool::ExecuteWorkerThread(FWorkerThread& WorkerThread)
+{
+    // Waits on pool worker threads help execute pending pool work
+    IGWTWaitHelper::SetCurrent(this);
+
+    while (! bIsStopping)
+    {
+        if (TryExecuteQueuedWork())
+        {
+            continue;
+        }
+
+        // Out of work, spin and yield before parking
+
+        const FGWTIdlePolicy ThreadIdlePolicy(IdlePolicy);
+
+        FPlatformAtomics::InterlockedIncrement(&SpinningThreadCount);
+
+        const bool bHasWork = ThreadIdlePolicy.SpinYield(
+            [this]()
+            {
+                return HasQueuedWork() || bIsStopping;
+            } );
+
+        FPlatformAtomics::InterlockedDecrement(&SpinningThreadCount);
+
+        if (bHasWork || ! ThreadIdlePolicy.bPark)
+        {
+            continue;
+        }
+
+        uint32 ParkTimeMs = MAX_uint32;
+
+        {
+            FScopeLock QueueScopeLock(&QueueLock);
+
+            // Work added before the lock was acquired, skip parking
+            if (QueuedWork.Num() > 0 || bIsStopping)
+            {
+                continue;
+            }
+
+            // Park until the earliest delayed work is due
+            if (DelayedWork.Num() > 0)
+            {
+                const double DelayTime = DelayedWork.HeapTop().IssueTime - FPlatformTime::Seconds();
+
+                if (DelayTime <= 0.0)
+                {
+                    continue;
+                }
+
+                ParkTimeMs = static_cast<uint32>(FMath::CeilToInt(FMath::Min(DelayTime * 1000.0, 1e6)));
+            }
+
+            ParkedThreads.Emplace(&WorkerThread);
+        }
+
+        // Timed out park, remove this thread from the parked thread list
+        if (! WorkerThread.WakeEvent->Wait(ParkTimeMs))
+        {
+            FScopeLock QueueScopeLock(&QueueLock);
+            ParkedThreads.RemoveSingleSwap(&WorkerThread, false);
+        }
+    }
+}
+
+// Executor
+
+bool FGWTAsyncThreadPool::Post(FExecutorCallback Callback)
+{
+    IQueuedWork* Work = new FExecutorWork(MoveTemp(Callback));
+
+    if (! AddQueuedWork(Work))
+    {
+        delete Work;
+        return false;
+    }
+
+    return true;
+}
+
+bool FGWTAsyncThreadPool::Defer(FExecutorCallback Callback)
+{
+    const FGWTTaskSchedule Schedule(IsInExecutorContext()
+        ? EGWTTaskPriority::Low
+        : EGWTTaskPriority::Normal);
+
+    IQueuedWork* Work = new FExecutorWork(MoveTemp(Callback));
+
+    if (! AddQueuedWork(Work, Schedule))
+    {
+        delete Work;
+        return false;
+    }
+
+    return true;
+}
+
+bool FGWTAsyncThreadPool::BulkPost(TArray<FExecutorCallback>&& Callbacks)
+{
+    TArray<IQueuedWork*> WorkBatch;
+    WorkBatch.Reserve(Callbacks.Num());
+
+    for (FExecutorCallback& Callback : Callbacks)
+    {
+        WorkBatch.Emplace(new FExecutorWork(MoveTemp(Callback)));
+    }
+
+    Callbacks.Reset();
+
+    if (! AddQueuedWorkBatch(WorkBatch))
+    {
+        for (IQueuedWork* Work : WorkBatch)
+        {
+            delete Work;
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
+bool FGWTAsyncThreadPool::IsInExecutorContext() const
+{
+    return IGWTWaitHelper::GetCurrent() == this;
+}
+
+// Async Task
+
+void FGWTAsyncTaskRef::EnqueueDoneCallback(const FTaskDoneCallback& DoneCallback, EGWTAsyncTaskState TaskState)
+{
+    if (IGenericWorkerThread::IsAvailable())
+    {
+        // Done callbacks are deferred, exempt from the callback queue limit
+        // and overflow policy, so task completion is never dropped
+        FGWTTickManager& TickManager(IGenericWorkerThread::Get().GetTickManager());
+        TickManager.Defer(
+            [DoneCallback, TaskState]()
+            {
+                DoneCallback(TaskState);
+            } );
+    }
+}
+
+bool UGWTAsyncTaskObject::ExecuteTask()
+{
+    TWeakObjectPtr<UGWTAsyncTaskObject> TaskObject(this);
+    const int32 Generation = PoolGeneration;
+
+    return TaskRef.EnqueueTask(
+        [TaskObject, Generation](EGWTAsyncTaskState TaskState)
+        {
+            // Object may have been reset and reused by another owner
+            if (TaskObject.IsValid() && TaskObject->PoolGeneration == Generation)
+            {
+                TaskObject->BroadcastTaskState(TaskState);
+            }
+        } );
+}
+
+void UGWTAsyncTaskObject::BroadcastTaskState(EGWTAsyncTaskState TaskState)
+{
+    if (TaskState == EGWTAsyncTaskState::Cancelled)
+    {
+        OnTaskCancelled.Broadcast();
+    }
+    else
+    {
+        OnTaskDone.Broadcast();
+    }
+}
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+
+#include "GWTCacheLine.h"
+#include "Containers/LockFreeList.h"
+
+namespace GWTCompletionCounter
+{
+    static const int32 SlabCounterCount = 64;
+
+    typedef TLockFreePointerListUnordered<FGWTCompletionCounter, GWT_CACHE_LINE_SIZE> FFreeList;
+
+    FFreeList& GetFreeList()
+    {
+        static FFreeList FreeList;
+        return FreeList;
+    }
+
+    // Allocates new slab, returns its first counter and
+    // pushes the remaining counters to the free list
+    FGWTCompletionCounter* AllocateSlab()
+    {
+        FGWTCompletionCounter* Slab = static_cast<FGWTCompletionCounter*>(
+            FMemory::Malloc(sizeof(FGWTCompletionCounter) * SlabCounterCount, GWT_CACHE_LINE_SIZE));
+
+        FFreeList& FreeList(GetFreeList());
+
+        for (int32 i=1; i<SlabCounterCount; ++i)
+        {
+            FreeList.Push(&Slab[i]);
+        }
+
+        return &Slab[0];
+    }
+}
+
+FGWTCompletionCounter* FGWTCompletionCounter::Allocate(int32 InCount)
+{
+    FGWTCompletionCounter* Counter = GWTCompletionCounter::GetFreeList().Pop();
+
+    if (! Counter)
+    {
+        Counter = GWTCompletionCounter::AllocateSlab();
+    }
+
+    FPlatformAtomics::InterlockedExchange(&Counter->Count, InCount);
+
+    return Counter;
+}
+
+void FGWTCompletionCounter::Free(FGWTCompletionCounter* Counter)
+{
+    GWTCompletionCounter::GetFreeList().Push(Counter);
+}
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/ThreadSafeBool.h"
+#include "GenericWorkerThread.h"
+#include "GWTCacheLine.h"
+
+#if !UE_BUILD_SHIPPING
+
+// False sharing microbenchmark. Each thread increments only its own counter,
+// adjacent counters share cache lines so every increment invalidates the line
+// on the other cores, padded counters keep each line local to its core.
+// Completion counter benchmark compares shared reference allocated counters
+// against the pooled cache line aligned completion counters.
+namespace GWTCacheLineBenchmark
+{
+    static const int32 MaxThreadCount = 256;
+
+    struct FAdjacentCounters
+    {
+        volatile int32 Counters[MaxThreadCount];
+    };
+
+    struct FPaddedCounters
+    {
+        TGWTCacheLinePadded<volatile int32> Counters[MaxThreadCount];
+    };
+
+    // Runs function on the thread count concurrently, returns elapsed seconds
+    double RunThreads(int32 ThreadCount, TFunction<void(int32)> Function)
+    {
+        FThreadSafeCounter ReadyCount;
+        FThreadSafeBool bStart(false);
+
+        TArray<TFuture<void>> Futures;
+        Futures.Reserve(ThreadCount);
+
+        for (int32 ThreadIndex=0; ThreadIndex<ThreadCount; ++ThreadIndex)
+        {
+            Futures.Emplace(Async<void>(
+                EAsyncExecution::Thread,
+                [&Function, &ReadyCount, &bStart, ThreadIndex]()
+                {
+                    ReadyCount.Increment();
+
+                    while (! bStart)
+                    {
+                        FPlatformProcess::Yield();
+                    }
+
+                    Function(ThreadIndex);
+                } ) );
+        }
+
+        while (ReadyCount.GetValue() < ThreadCount)
+        {
+            FPlatformProcess::Yield();
+        }
+
+        const double StartTime = FPlatformTime::Seconds();
+
+        bStart = true;
+
+        for (TFuture<void>& Future : Futures)
+        {
+            Future.Wait();
+        }
+
+        return FPlatformTime::Seconds() - StartTime;
+    }
+
+    void LogResult(const TCHAR* Name, double BaselineTime, double OptimizedTime, int64 OperationCount)
+    {
+        UE_LOG(LogGWT, Log,
+            TEXT("GWT.Bench.CacheLine - %s: %.2f ns/op -> %.2f ns/op (%.2fx)"),
+            Name,
+            BaselineTime * 1e9 / OperationCount,
+            OptimizedTime * 1e9 / OperationCount,
+            (OptimizedTime > 0.0) ? (BaselineTime / OptimizedTime) : 0.0
+            );
+    }
+
+    void Run(const TArray<FString>& Args)
+    {
+        const int32 ThreadCount = FMath::Clamp((Args.Num() > 0) ? FCString::Atoi(*Args[0]) : FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1, MaxThreadCount);
+        const int32 IterationCount = FMath::Max((Args.Num() > 1) ? FCString::Atoi(*Args[1]) : 1000000, 1);
+        const int64 OperationCount = static_cast<int64>(ThreadCount) * IterationCount;
+
+        UE_LOG(LogGWT, Log, TEXT("GWT.Bench.CacheLine - Threads: %d, Iterations: %d, Cache Line: %d bytes"), ThreadCount, IterationCount, GWT_CACHE_LINE_SIZE);
+
+        // Per-thread counters
+
+        TUniquePtr<FAdjacentCounters> AdjacentCounters(MakeUnique<FAdjacentCounters>());
+        TUniquePtr<FPaddedCounters> PaddedCounters(MakeUnique<FPaddedCounters>());
+
+        const double AdjacentTime = RunThreads(ThreadCount,
+            [&AdjacentCounters, IterationCount](int32 ThreadIndex)
+            {
+                volatile int32* Counter = &AdjacentCounters->Counters[ThreadIndex];
+
+                for (int32 i=0; i<IterationCount; ++i)
+                {
+                    FPlatformAtomics::InterlockedIncrement(Counter);
+                }
+            } );
+
+        const double PaddedTime = RunThreads(ThreadCount,
+            [&PaddedCounters, IterationCount](int32 ThreadIndex)
+            {
+                volatile int32* Counter = &PaddedCounters->Counters[ThreadIndex].Value;
+
+                for (int32 i=0; i<IterationCount; ++i)
+                {
+                    FPlatformAtomics::InterlockedIncrement(Counter);
+                }
+            } );
+
+        LogResult(TEXT("Per-thread counter increment"), AdjacentTime, PaddedTime, OperationCount);
+
+        // Completion counters, allocation and release per operation
+
+        const int32 CounterIterationCount = FMath::Max(IterationCount / 16, 1);
+        const int64 CounterOperationCount = static_cast<int64>(ThreadCount) * CounterIterationCount;
+
+        const double SharedCounterTime = RunThreads(ThreadCount,
+            [CounterIterationCount](int32 ThreadIndex)
+            {
+                for (int32 i=0; i<CounterIterationCount; ++i)
+                {
+                    TSharedRef<FThreadSafeCounter> Counter(new FThreadSafeCounter(2));
+                    TSharedRef<FThreadSafeCounter> CounterCopy(Counter);
+                    Counter->Decrement();
+                    CounterCopy->Decrement();
+                }
+            } );
+
+        const double PooledCounterTime = RunThreads(ThreadCount,
+            [CounterIterationCount](int32 ThreadIndex)
+            {
+                for (int32 i=0; i<CounterIterationCount; ++i)
+                {
+                    FGWTCompletionCounter* Counter = FGWTCompletionCounter::Allocate(2);
+                    Counter->Decrement();
+                    Counter->Decrement();
+                }
+            } );
+
+        LogResult(TEXT("Completion counter lifetime"), SharedCounterTime, PooledCounterTime, CounterOperationCount);
+    }
+}
+
+static FAutoConsoleCommand GWTCacheLineBenchmarkCommand(
+    TEXT("GWT.Bench.CacheLine"),
+    TEXT("Run GenericWorkerThread false sharing microbenchmark. Optional arguments: thread count, iteration count"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&GWTCacheLineBenchmark::Run) );
+
+#endif // !UE_BUILD_SHIPPING
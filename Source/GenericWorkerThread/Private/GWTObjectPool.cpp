@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "GWTObjectPool.h"
+#include "GenericWorkerThread.h"
+#include "GWTAsyncThreadPool.h"
+#include "GWTAsyncTypes.h"
+#include "GWTTickUtilities.h"
+
+FGWTObjectPool::FGWTObjectPool()
+    : MaxFreeObjectCount(1024)
+    , AllocatedCount(0)
+    , ReusedCount(0)
+{
+}
+
+void FGWTObjectPool::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    for (TPair<UClass*, TArray<UObject*>>& FreeObjectPair : FreeObjects)
+    {
+        Collector.AddReferencedObjects(FreeObjectPair.Value);
+    }
+}
+
+UObject* FGWTObjectPool::PopFreeObject(UClass* ObjectClass)
+{
+    TArray<UObject*>* FreeObjectList = FreeObjects.Find(ObjectClass);
+
+    if (FreeObjectList)
+    {
+        while (FreeObjectList->Num() > 0)
+        {
+            UObject* FreeObject = FreeObjectList->Pop(false);
+
+            if (IsValid(FreeObject))
+            {
+                return FreeObject;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+bool FGWTObjectPool::Release(UObject* Object)
+{
+    check(IsInGameThread());
+
+    if (! IsValid(Object))
+    {
+        return false;
+    }
+
+    bool bIsReset = false;
+
+    if (UGWTTaskEventObject* TaskEventObject = Cast<UGWTTaskEventObject>(Object))
+    {
+        bIsReset = TaskEventObject->ResetPooledObject();
+    }
+    else if (UGWTAsyncTaskObject* AsyncTaskObject = Cast<UGWTAsyncTaskObject>(Object))
+    {
+        bIsReset = AsyncTaskObject->ResetPooledObject();
+    }
+    else if (UGWTPromiseObject* PromiseObject = Cast<UGWTPromiseObject>(Object))
+    {
+        bIsReset = PromiseObject->ResetPooledObject();
+    }
+    else if (UGWTTickEvent* TickEvent = Cast<UGWTTickEvent>(Object))
+    {
+        bIsReset = TickEvent->ResetPooledObject();
+    }
+
+    if (! bIsReset)
+    {
+        return false;
+    }
+
+    TArray<UObject*>& FreeObjectList(FreeObjects.FindOrAdd(Object->GetClass()));
+
+    if (FreeObjectList.Num() >= MaxFreeObjectCount)
+    {
+        return false;
+    }
+
+    checkSlow(! FreeObjectList.Contains(Object));
+    FreeObjectList.Emplace(Object);
+
+    return true;
+}
+
+void FGWTObjectPool::Empty()
+{
+    check(IsInGameThread());
+    FreeObjects.Empty();
+}
+
+int32 FGWTObjectPool::GetFreeObjectCount() const
+{
+    int32 FreeObjectCount = 0;
+
+    for (const TPair<UClass*, TArray<UObject*>>& FreeObjectPair : FreeObjects)
+    {
+        FreeObjectCount += FreeObjectPair.Value.Num();
+    }
+
+    return FreeObjectCount;
+}
+
+UGWTTaskEventObject* UGWTObjectPoolLibrary::AcquireTaskEventObject()
+{
+    return IGenericWorkerThread::Get().GetObjectPool().Acquire<UGWTTaskEventObject>();
+}
+
+UGWTAsyncTaskObject* UGWTObjectPoolLibrary::AcquireAsyncTaskObject()
+{
+    return IGenericWorkerThread::Get().GetObjectPool().Acquire<UGWTAsyncTaskObject>();
+}
+
+UGWTPromiseObject* UGWTObjectPoolLibrary::AcquirePromiseObject()
+{
+    return IGenericWorkerThread::Get().GetObjectPool().Acquire<UGWTPromiseObject>();
+}
+
+UGWTTickEvent* UGWTObjectPoolLibrary::AcquireTickEvent()
+{
+    return IGenericWorkerThread::Get().GetObjectPool().Acquire<UGWTTickEvent>();
+}
+
+bool UGWTObjectPoolLibrary::ReleaseObject(UObject* Object)
+{
+    return IGenericWorkerThread::Get().GetObjectPool().Release(Object);
+}
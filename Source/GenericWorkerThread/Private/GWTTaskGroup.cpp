@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+
+#include "GWTTaskGroup.h"
+#include "GWTTrace.h"
+
+struct FGWTTaskGroupContext
+{
+    FGWTAsyncThreadPool& ThreadPool;
+    FPRGWTAsyncTaskState TaskState;
+    TFunction<void()> CompletionCallback;
+
+    FGWTTaskGroupContext(
+        FGWTAsyncThreadPool& InThreadPool,
+        const FPRGWTAsyncTaskState& InTaskState,
+        TFunction<void()>&& InCompletionCallback
+        )
+        : ThreadPool(InThreadPool)
+        , TaskState(InTaskState)
+        , CompletionCallback(MoveTemp(InCompletionCallback))
+    {
+    }
+};
+
+typedef TSharedRef<FGWTTaskGroupContext, ESPMode::ThreadSafe> FPRGWTTaskGroupContext;
+
+// Task group task node. Pending count holds one reference for the task
+// function and one reference for each spawned child task that has not
+// completed yet, the node completes and releases its parent once the
+// pending count reaches zero.
+class FGWTTaskGroupNode : public IQueuedWork
+{
+    FPRGWTTaskGroupContext Context;
+    FGWTTaskGroupNode* const Parent;
+    FGWTTaskGroupFunction Function;
+    volatile int32 PendingCount;
+
+public:
+
+    FGWTTaskGroupNode(const FPRGWTTaskGroupContext& InContext, FGWTTaskGroupNode* InParent, FGWTTaskGroupFunction&& InFunction)
+        : Context(InContext)
+        , Parent(InParent)
+        , Function(MoveTemp(InFunction))
+        , PendingCount(1)
+    {
+    }
+
+    FORCEINLINE FGWTTaskGroupContext& GetContext() const
+    {
+        return *Context;
+    }
+
+    FORCEINLINE bool IsCancelled() const
+    {
+        return Context->TaskState->Get() == EGWTAsyncTaskState::Cancelled;
+    }
+
+    // Queues node to the thread pool, executes node on the calling thread
+    // if the thread pool does not accept the work
+    void Enqueue()
+    {
+        if (! Context->ThreadPool.AddQueuedWork(this))
+        {
+            DoThreadedWork();
+        }
+    }
+
+    void SpawnChild(FGWTTaskGroupFunction&& ChildFunction)
+    {
+        // Reference must be added before the child is visible to the pool
+        FPlatformAtomics::InterlockedIncrement(&PendingCount);
+
+        FGWTTaskGroupNode* Child = new FGWTTaskGroupNode(Context, this, MoveTemp(ChildFunction));
+        Child->Enqueue();
+    }
+
+    // -- BEGIN IQueuedWork
+
+    virtual void DoThreadedWork() override
+    {
+        {
+            GWT_TRACE_SCOPE("GWT.TaskGroup.Task");
+
+            if (! IsCancelled())
+            {
+                FGWTTaskScope Scope(*this);
+                Function(Scope);
+            }
+
+            // Release captured function state before descendants complete
+            Function = nullptr;
+        }
+
+        Release();
+    }
+
+    virtual void Abandon() override
+    {
+        Function = nullptr;
+        Release();
+    }
+
+    // -- END IQueuedWork
+
+private:
+
+    void Release()
+    {
+        if (FPlatformAtomics::InterlockedDecrement(&PendingCount) != 0)
+        {
+            return;
+        }
+
+        FGWTTaskGroupNode* ParentNode = Parent;
+        FPRGWTTaskGroupContext GroupContext(Context);
+
+        delete this;
+
+        if (ParentNode)
+        {
+            ParentNode->Release();
+        }
+        else if (GroupContext->CompletionCallback)
+        {
+            GWT_TRACE_EVENT("GWT.TaskGroup.Done");
+            GroupContext->CompletionCallback();
+        }
+    }
+};
+
+void FGWTTaskScope::Spawn(FGWTTaskGroupFunction Function)
+{
+    if (Function)
+    {
+        Node.SpawnChild(MoveTemp(Function));
+    }
+}
+
+bool FGWTTaskScope::IsCancelled() const
+{
+    return Node.IsCancelled();
+}
+
+FGWTAsyncThreadPool& FGWTTaskScope::GetThreadPool() const
+{
+    return Node.GetContext().ThreadPool;
+}
+
+TFuture<void> FGWTTaskGroup::Launch(FGWTAsyncThreadPool& ThreadPool, FGWTTaskGroupFunction RootFunction)
+{
+    TSharedRef<TPromise<void>, ESPMode::ThreadSafe> Promise(MakeShared<TPromise<void>, ESPMode::ThreadSafe>());
+    TFuture<void> Future(Promise->GetFuture());
+
+    FPRGWTAsyncTaskState TaskState(MakeShared<FGWTAsyncTaskState, ESPMode::ThreadSafe>());
+    TaskState->Set(EGWTAsyncTaskState::Running);
+
+    GWTLaunchTaskGroup(
+        ThreadPool,
+        MoveTemp(RootFunction),
+        [Promise]()
+        {
+            Promise->SetValue();
+        },
+        TaskState
+        );
+
+    return Future;
+}
+
+void GWTLaunchTaskGroup(
+    FGWTAsyncThreadPool& ThreadPool,
+    FGWTTaskGroupFunction RootFunction,
+    TFunction<void()> CompletionCallback,
+    const FPRGWTAsyncTaskState& TaskState
+    )
+{
+    FPRGWTTaskGroupContext Context(
+        MakeShared<FGWTTaskGroupContext, ESPMode::ThreadSafe>(
+            ThreadPool,
+            TaskState,
+            MoveTemp(CompletionCallback)
+            ) );
+
+    FGWTTaskGroupNode* RootNode = new FGWTTaskGroupNode(Context, nullptr, MoveTemp(RootFunction));
+    RootNode->Enqueue();
+}
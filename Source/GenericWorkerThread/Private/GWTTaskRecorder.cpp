@@ -0,0 +1,548 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+
+#include "GWTTaskRecorder.h"
+#include "Containers/Queue.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/Archive.h"
+#include "GenericWorkerThread.h"
+
+namespace GWTTaskRecorder
+{
+    static const uint32 FileMagic = 0x52545747; // GWTR
+    static const uint32 FileVersion = 2;
+
+    double StartSeconds = 0.0;
+
+    // Chain ids are never reused across recordings, chains of earlier
+    // recordings that are still executing are identified by their id
+    volatile int32 ChainIdCounter = 0;
+    volatile int32 FirstChainId = 1;
+
+    TQueue<FGWTRecordedChain, EQueueMode::Mpsc> ChainQueue;
+    TQueue<FGWTRecordedTask, EQueueMode::Mpsc> TaskQueue;
+
+    // Records drained from the queues, guarded by the record lock
+    FCriticalSection RecordLock;
+    FGWTTaskRecording Recording;
+
+    // 64-bit microseconds, recordings of any length do not saturate
+    FORCEINLINE uint64 ToRecordTime(double Seconds)
+    {
+        return static_cast<uint64>(FMath::Max((Seconds - StartSeconds) * 1e6, 0.0));
+    }
+
+    // Queue consumer, record lock must be held
+    void DrainQueues()
+    {
+        FGWTRecordedChain Chain;
+        FGWTRecordedTask Task;
+
+        while (ChainQueue.Dequeue(Chain))
+        {
+            Recording.Chains.Emplace(Chain);
+        }
+
+        const uint32 MinChainId = static_cast<uint32>(FPlatformAtomics::AtomicRead(&FirstChainId));
+
+        while (TaskQueue.Dequeue(Task))
+        {
+            // Task of a chain submitted during an earlier recording
+            if (Task.ChainId >= MinChainId)
+            {
+                Recording.Tasks.Emplace(Task);
+            }
+        }
+    }
+}
+
+// Recording
+
+FArchive& operator<<(FArchive& Ar, FGWTTaskRecording& Recording)
+{
+    uint32 Magic = GWTTaskRecorder::FileMagic;
+    uint32 Version = GWTTaskRecorder::FileVersion;
+
+    Ar << Magic;
+    Ar << Version;
+
+    if (Ar.IsLoading() && (Magic != GWTTaskRecorder::FileMagic || Version != GWTTaskRecorder::FileVersion))
+    {
+        Ar.SetError();
+        return Ar;
+    }
+
+    Ar << Recording.Chains;
+    Ar << Recording.Tasks;
+
+    return Ar;
+}
+
+bool FGWTTaskRecording::SaveToFile(const FString& FilePath)
+{
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+
+    if (! Writer)
+    {
+        UE_LOG(LogGWT, Warning, TEXT("FGWTTaskRecording::SaveToFile() - Unable to create recording file %s"), *FilePath);
+        return false;
+    }
+
+    *Writer << *this;
+
+    return Writer->Close();
+}
+
+bool FGWTTaskRecording::LoadFromFile(const FString& FilePath)
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+
+    if (! Reader)
+    {
+        UE_LOG(LogGWT, Warning, TEXT("FGWTTaskRecording::LoadFromFile() - Unable to open recording file %s"), *FilePath);
+        return false;
+    }
+
+    *Reader << *this;
+
+    if (Reader->IsError())
+    {
+        UE_LOG(LogGWT, Warning, TEXT("FGWTTaskRecording::LoadFromFile() - Invalid recording file %s"), *FilePath);
+        Chains.Empty();
+        Tasks.Empty();
+        return false;
+    }
+
+    return Reader->Close();
+}
+
+// Recorder
+
+volatile int32 FGWTTaskRecorder::bIsRecording = 0;
+
+void FGWTTaskRecorder::Start()
+{
+    FScopeLock ScopeLock(&GWTTaskRecorder::RecordLock);
+
+    Stop();
+
+    // Discard records of the previous recording
+    GWTTaskRecorder::DrainQueues();
+    GWTTaskRecorder::Recording.Chains.Reset();
+    GWTTaskRecorder::Recording.Tasks.Reset();
+
+    GWTTaskRecorder::StartSeconds = FPlatformTime::Seconds();
+    const int32 LastChainId = FPlatformAtomics::AtomicRead(&GWTTaskRecorder::ChainIdCounter);
+    FPlatformAtomics::InterlockedExchange(&GWTTaskRecorder::FirstChainId, LastChainId + 1);
+    FPlatformAtomics::InterlockedExchange(&bIsRecording, 1);
+}
+
+void FGWTTaskRecorder::Stop()
+{
+    FPlatformAtomics::InterlockedExchange(&bIsRecording, 0);
+}
+
+void FGWTTaskRecorder::GetRecording(FGWTTaskRecording& OutRecording)
+{
+    FScopeLock ScopeLock(&GWTTaskRecorder::RecordLock);
+    GWTTaskRecorder::DrainQueues();
+    OutRecording = GWTTaskRecorder::Recording;
+}
+
+bool FGWTTaskRecorder::Export(const FString& FilePath)
+{
+    FGWTTaskRecording Recording;
+    GetRecording(Recording);
+    return Recording.SaveToFile(FilePath);
+}
+
+uint32 FGWTTaskRecorder::BeginChain(int32 StageCount)
+{
+    if (! IsRecording())
+    {
+        return 0;
+    }
+
+    FGWTRecordedChain Chain;
+    Chain.ChainId = static_cast<uint32>(FPlatformAtomics::InterlockedIncrement(&GWTTaskRecorder::ChainIdCounter));
+    Chain.SubmitTime = GWTTaskRecorder::ToRecordTime(FPlatformTime::Seconds());
+    Chain.StageCount = static_cast<uint16>(FMath::Clamp(StageCount, 0, static_cast<int32>(MAX_uint16)));
+
+    GWTTaskRecorder::ChainQueue.Enqueue(Chain);
+
+    return Chain.ChainId;
+}
+
+void FGWTTaskRecorder::RecordTask(uint32 ChainId, int32 StageIndex, int32 TaskIndex, double StartTime, double EndTime)
+{
+    if (ChainId == 0 || ! IsRecording())
+    {
+        return;
+    }
+
+    // Chain has been submitted before the current recording started
+    if (ChainId < static_cast<uint32>(FPlatformAtomics::AtomicRead(&GWTTaskRecorder::FirstChainId)))
+    {
+        return;
+    }
+
+    FGWTRecordedTask Task;
+    Task.ChainId = ChainId;
+    Task.StageIndex = static_cast<uint16>(FMath::Clamp(StageIndex, 0, static_cast<int32>(MAX_uint16)));
+    Task.TaskIndex = static_cast<uint16>(FMath::Clamp(TaskIndex, 0, static_cast<int32>(MAX_uint16)));
+    Task.StartTime = GWTTaskRecorder::ToRecordTime(StartTime);
+    Task.Duration = static_cast<uint32>(FMath::Clamp((EndTime - StartTime) * 1e6, 0.0, static_cast<double>(MAX_uint32)));
+
+    GWTTaskRecorder::TaskQueue.Enqueue(Task);
+}
+
+TFunction<void()> FGWTTaskRecorder::WrapTask(TFunction<void()> TaskCallback, uint32 ChainId, int32 StageIndex, int32 TaskIndex)
+{
+    if (ChainId == 0)
+    {
+        return TaskCallback;
+    }
+
+    return [TaskCallback, ChainId, StageIndex, TaskIndex]()
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        TaskCallback();
+        FGWTTaskRecorder::RecordTask(ChainId, StageIndex, TaskIndex, StartTime, FPlatformTime::Seconds());
+    };
+}
+
+// Replay
+
+FGWTTaskReplayResult FGWTTaskReplay::Simulate(const FGWTTaskRecording& Recording, int32 WorkerCount, const FDurationFunction& DurationFunction)
+{
+    struct FStage
+    {
+        TArray<double> Durations;
+    };
+
+    struct FChain
+    {
+        double SubmitTime = 0.0;
+        TArray<FStage> Stages;
+        int32 StageIndex = 0;
+        int32 PendingCount = 0;
+    };
+
+    struct FReadyTask
+    {
+        int32 ChainIndex;
+        double Duration;
+        double ReadyTime;
+    };
+
+    enum class EEventType : uint8
+    {
+        Submit,
+        Finish
+    };
+
+    struct FEvent
+    {
+        double Time;
+        uint64 Sequence;
+        int32 ChainIndex;
+        EEventType Type;
+
+        FORCEINLINE bool operator<(const FEvent& Other) const
+        {
+            return (Time != Other.Time) ? (Time < Other.Time) : (Sequence < Other.Sequence);
+        }
+    };
+
+    FGWTTaskReplayResult Result;
+    Result.WorkerCount = FMath::Max(WorkerCount, 1);
+
+    // Build chain stages from the recorded tasks
+
+    TArray<FChain> Chains;
+    TMap<uint32, int32> ChainIndexMap;
+
+    Chains.Reserve(Recording.Chains.Num());
+
+    for (const FGWTRecordedChain& RecordedChain : Recording.Chains)
+    {
+        ChainIndexMap.Emplace(RecordedChain.ChainId, Chains.Num());
+
+        FChain& Chain(Chains.AddDefaulted_GetRef());
+        Chain.SubmitTime = RecordedChain.SubmitTime * 1e-6;
+        Chain.Stages.SetNum(RecordedChain.StageCount);
+    }
+
+    TArray<const FGWTRecordedTask*> SortedTasks;
+    SortedTasks.Reserve(Recording.Tasks.Num());
+
+    for (const FGWTRecordedTask& Task : Recording.Tasks)
+    {
+        SortedTasks.Emplace(&Task);
+    }
+
+    // Stable task order within stages regardless of record order
+    SortedTasks.Sort(
+        [](const FGWTRecordedTask& A, const FGWTRecordedTask& B)
+        {
+            if (A.ChainId != B.ChainId)
+            {
+                return A.ChainId < B.ChainId;
+            }
+
+            return (A.StageIndex != B.StageIndex) ? (A.StageIndex < B.StageIndex) : (A.TaskIndex < B.TaskIndex);
+        } );
+
+    for (const FGWTRecordedTask* Task : SortedTasks)
+    {
+        const int32* ChainIndex = ChainIndexMap.Find(Task->ChainId);
+
+        if (! ChainIndex || ! Chains[*ChainIndex].Stages.IsValidIndex(Task->StageIndex))
+        {
+            continue;
+        }
+
+        const double Duration = DurationFunction ? DurationFunction(*Task) : (Task->Duration * 1e-6);
+        Chains[*ChainIndex].Stages[Task->StageIndex].Durations.Emplace(FMath::Max(Duration, 0.0));
+
+        ++Result.TaskCount;
+        Result.TotalTaskTime += FMath::Max(Duration, 0.0);
+    }
+
+    Result.ChainCount = Chains.Num();
+
+    if (Chains.Num() == 0)
+    {
+        return Result;
+    }
+
+    // Discrete event simulation
+
+    TArray<FEvent> Events;
+    TArray<FReadyTask> ReadyTasks;
+    int32 ReadyHead = 0;
+    uint64 EventSequence = 0;
+    int32 IdleWorkerCount = Result.WorkerCount;
+
+    double FirstSubmitTime = TNumericLimits<double>::Max();
+    double LastFinishTime = 0.0;
+    double TotalChainLatency = 0.0;
+    double TotalQueueWait = 0.0;
+    int32 StartedTaskCount = 0;
+
+    for (int32 i=0; i<Chains.Num(); ++i)
+    {
+        Events.HeapPush({ Chains[i].SubmitTime, EventSequence++, i, EEventType::Submit });
+        FirstSubmitTime = FMath::Min(FirstSubmitTime, Chains[i].SubmitTime);
+    }
+
+    // Makes the current chain stage ready, skipping empty stages.
+    // Returns false once the chain has no remaining stage.
+    auto ReadyStage = [&](int32 ChainIndex, double Time)
+    {
+        FChain& Chain(Chains[ChainIndex]);
+
+        for (; Chain.StageIndex < Chain.Stages.Num(); ++Chain.StageIndex)
+        {
+            const FStage& Stage(Chain.Stages[Chain.StageIndex]);
+
+            if (Stage.Durations.Num() > 0)
+            {
+                Chain.PendingCount = Stage.Durations.Num();
+
+                for (double Duration : Stage.Durations)
+                {
+                    ReadyTasks.Add({ ChainIndex, Duration, Time });
+                }
+
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    auto CompleteChain = [&](int32 ChainIndex, double Time)
+    {
+        const double Latency = Time - Chains[ChainIndex].SubmitTime;
+        TotalChainLatency += Latency;
+        Result.MaxChainLatency = FMath::Max(Result.MaxChainLatency, Latency);
+        LastFinishTime = FMath::Max(LastFinishTime, Time);
+    };
+
+    while (Events.Num() > 0)
+    {
+        FEvent Event;
+        Events.HeapPop(Event, false);
+
+        const double CurrentTime = Event.Time;
+
+        if (Event.Type == EEventType::Submit)
+        {
+            if (! ReadyStage(Event.ChainIndex, CurrentTime))
+            {
+                CompleteChain(Event.ChainIndex, CurrentTime);
+            }
+        }
+        else
+        {
+            ++IdleWorkerCount;
+            LastFinishTime = FMath::Max(LastFinishTime, CurrentTime);
+
+            FChain& Chain(Chains[Event.ChainIndex]);
+
+            if (--Chain.PendingCount == 0)
+            {
+                ++Chain.StageIndex;
+
+                if (! ReadyStage(Event.ChainIndex, CurrentTime))
+                {
+                    CompleteChain(Event.ChainIndex, CurrentTime);
+                }
+            }
+        }
+
+        // Dispatch ready tasks to idle workers
+        while (IdleWorkerCount > 0 && ReadyHead < ReadyTasks.Num())
+        {
+            const FReadyTask& ReadyTask(ReadyTasks[ReadyHead++]);
+
+            const double QueueWait = CurrentTime - ReadyTask.ReadyTime;
+            TotalQueueWait += QueueWait;
+            Result.MaxQueueWait = FMath::Max(Result.MaxQueueWait, QueueWait);
+            ++StartedTaskCount;
+
+            --IdleWorkerCount;
+            Events.HeapPush({ CurrentTime + ReadyTask.Duration, EventSequence++, ReadyTask.ChainIndex, EEventType::Finish });
+        }
+    }
+
+    Result.Makespan = FMath::Max(LastFinishTime - FirstSubmitTime, 0.0);
+    Result.AverageChainLatency = TotalChainLatency / Chains.Num();
+    Result.AverageQueueWait = (StartedTaskCount > 0) ? (TotalQueueWait / StartedTaskCount) : 0.0;
+    Result.Utilization = (Result.Makespan > 0.0)
+        ? (Result.TotalTaskTime / (Result.Makespan * Result.WorkerCount))
+        : 0.0;
+
+    return Result;
+}
+
+FGWTTaskReplay::FDurationFunction FGWTTaskReplay::ScaledDuration(double Scale)
+{
+    return [Scale](const FGWTRecordedTask& Task)
+    {
+        return Task.Duration * 1e-6 * Scale;
+    };
+}
+
+// Console Commands
+
+static FAutoConsoleCommand GWTTaskRecordStartCommand(
+    TEXT("GWT.TaskRecord.Start"),
+    TEXT("Start recording GenericWorkerThread task chain graphs and task timings"),
+    FConsoleCommandDelegate::CreateStatic(&FGWTTaskRecorder::Start) );
+
+static FAutoConsoleCommand GWTTaskRecordStopCommand(
+    TEXT("GWT.TaskRecord.Stop"),
+    TEXT("Stop recording GenericWorkerThread task chain graphs"),
+    FConsoleCommandDelegate::CreateStatic(&FGWTTaskRecorder::Stop) );
+
+static FAutoConsoleCommand GWTTaskRecordExportCommand(
+    TEXT("GWT.TaskRecord.Export"),
+    TEXT("Export recorded GenericWorkerThread task chain graphs as binary file. Optional argument: file path"),
+    FConsoleCommandWithArgsDelegate::CreateLambda(
+        [](const TArray<FString>& Args)
+        {
+            const FString FilePath = (Args.Num() > 0)
+                ? Args[0]
+                : FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("GWTTaskRecord.gwtr");
+
+            if (FGWTTaskRecorder::Export(FilePath))
+            {
+                UE_LOG(LogGWT, Log, TEXT("GWT.TaskRecord.Export - Recording exported to %s"), *FilePath);
+            }
+        } ) );
+
+static FAutoConsoleCommand GWTTaskReplayCommand(
+    TEXT("GWT.TaskReplay"),
+    TEXT("Simulate recorded GenericWorkerThread task chain graphs. Arguments: file path, worker counts (e.g. 16 32), optional Scale=<duration scale>"),
+    FConsoleCommandWithArgsDelegate::CreateLambda(
+        [](const TArray<FString>& Args)
+        {
+            if (Args.Num() < 2)
+            {
+                UE_LOG(LogGWT, Warning, TEXT("GWT.TaskReplay - Usage: GWT.TaskReplay <FilePath> <WorkerCount>... [Scale=<DurationScale>]"));
+                return;
+            }
+
+            FGWTTaskRecording Recording;
+
+            if (! Recording.LoadFromFile(Args[0]))
+            {
+                return;
+            }
+
+            double DurationScale = 1.0;
+            TArray<int32> WorkerCounts;
+
+            for (int32 i=1; i<Args.Num(); ++i)
+            {
+                FString ScaleString;
+
+                if (Args[i].Split(TEXT("Scale="), nullptr, &ScaleString))
+                {
+                    DurationScale = FCString::Atod(*ScaleString);
+                }
+                else if (Args[i].IsNumeric())
+                {
+                    WorkerCounts.Emplace(FCString::Atoi(*Args[i]));
+                }
+            }
+
+            for (int32 WorkerCount : WorkerCounts)
+            {
+                const FGWTTaskReplayResult Result(
+                    FGWTTaskReplay::Simulate(Recording, WorkerCount, FGWTTaskReplay::ScaledDuration(DurationScale)));
+
+                UE_LOG(LogGWT, Log,
+                    TEXT("GWT.TaskReplay - Workers: %d, Chains: %d, Tasks: %d, Makespan: %.3f ms, Utilization: %.1f%%, Chain Latency: %.3f ms avg / %.3f ms max, Queue Wait: %.3f ms avg / %.3f ms max"),
+                    Result.WorkerCount,
+                    Result.ChainCount,
+                    Result.TaskCount,
+                    Result.Makespan * 1e3,
+                    Result.Utilization * 100.0,
+                    Result.AverageChainLatency * 1e3,
+                    Result.MaxChainLatency * 1e3,
+                    Result.AverageQueueWait * 1e3,
+                    Result.MaxQueueWait * 1e3
+                    );
+            }
+        } ) );
@@ -0,0 +1,646 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+
+#include "GWTTelemetry.h"
+#include "HAL/FileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "GenericWorkerThread.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include "Windows/WindowsHWrapper.h"
+#include "Windows/HideWindowsPlatformTypes.h"
+#define GWT_MAPPED_FILE_WINDOWS 1
+#elif PLATFORM_UNIX || PLATFORM_MAC || PLATFORM_ANDROID
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define GWT_MAPPED_FILE_POSIX 1
+#endif
+
+#ifndef GWT_MAPPED_FILE_WINDOWS
+#define GWT_MAPPED_FILE_WINDOWS 0
+#endif
+
+#ifndef GWT_MAPPED_FILE_POSIX
+#define GWT_MAPPED_FILE_POSIX 0
+#endif
+
+// Mapped File
+
+class FGWTMappedFile
+{
+public:
+
+    ~FGWTMappedFile()
+    {
+        Close();
+    }
+
+    // Maps the whole file. Writable mapping creates the file if required
+    // and resizes the file to the specified size, read-only mapping ignores
+    // the specified size.
+    bool Open(const FString& FilePath, int64 InSize, bool bInWritable)
+    {
+        Close();
+
+        const FString FullPath(FPaths::ConvertRelativePathToFull(FilePath));
+        bWritable = bInWritable;
+
+        if (bWritable)
+        {
+            IFileManager::Get().MakeDirectory(*FPaths::GetPath(FullPath), true);
+        }
+
+#if GWT_MAPPED_FILE_WINDOWS
+        FileHandle = CreateFileW(
+            *FullPath,
+            GENERIC_READ | (bWritable ? GENERIC_WRITE : 0),
+            FILE_SHARE_READ | FILE_SHARE_WRITE,
+            nullptr,
+            bWritable ? OPEN_ALWAYS : OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr
+            );
+
+        if (FileHandle == INVALID_HANDLE_VALUE)
+        {
+            FileHandle = nullptr;
+            return false;
+        }
+
+        if (! bWritable)
+        {
+            LARGE_INTEGER FileSize;
+
+            if (! GetFileSizeEx(FileHandle, &FileSize))
+            {
+                Close();
+                return false;
+            }
+
+            InSize = FileSize.QuadPart;
+        }
+
+        if (InSize <= 0)
+        {
+            Close();
+            return false;
+        }
+
+        // Writable mapping extends the file to the mapping size
+        MappingHandle = CreateFileMappingW(
+            FileHandle,
+            nullptr,
+            bWritable ? PAGE_READWRITE : PAGE_READONLY,
+            static_cast<DWORD>(static_cast<uint64>(InSize) >> 32),
+            static_cast<DWORD>(static_cast<uint64>(InSize) & 0xFFFFFFFF),
+            nullptr
+            );
+
+        if (! MappingHandle)
+        {
+            Close();
+            return false;
+        }
+
+        Data = static_cast<uint8*>(MapViewOfFile(MappingHandle, bWritable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, static_cast<SIZE_T>(InSize)));
+#elif GWT_MAPPED_FILE_POSIX
+        FileDescriptor = open(TCHAR_TO_UTF8(*FullPath), bWritable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+
+        if (FileDescriptor < 0)
+        {
+            return false;
+        }
+
+        struct stat FileStat;
+
+        if (fstat(FileDescriptor, &FileStat) != 0)
+        {
+            Close();
+            return false;
+        }
+
+        if (! bWritable)
+        {
+            InSize = FileStat.st_size;
+        }
+        else if (FileStat.st_size != InSize && ftruncate(FileDescriptor, InSize) != 0)
+        {
+            Close();
+            return false;
+        }
+
+        if (InSize <= 0)
+        {
+            Close();
+            return false;
+        }
+
+        void* MappedData = mmap(nullptr, InSize, PROT_READ | (bWritable ? PROT_WRITE : 0), MAP_SHARED, FileDescriptor, 0);
+        Data = (MappedData != MAP_FAILED) ? static_cast<uint8*>(MappedData) : nullptr;
+#endif
+
+        if (! Data)
+        {
+            Close();
+            return false;
+        }
+
+        Size = InSize;
+        return true;
+    }
+
+    void Close()
+    {
+#if GWT_MAPPED_FILE_WINDOWS
+        if (Data)
+        {
+            if (bWritable)
+            {
+                FlushViewOfFile(Data, 0);
+            }
+
+            UnmapViewOfFile(Data);
+        }
+
+        if (MappingHandle)
+        {
+            CloseHandle(MappingHandle);
+            MappingHandle = nullptr;
+        }
+
+        if (FileHandle)
+        {
+            CloseHandle(FileHandle);
+            FileHandle = nullptr;
+        }
+#elif GWT_MAPPED_FILE_POSIX
+        if (Data)
+        {
+            if (bWritable)
+            {
+                msync(Data, Size, MS_ASYNC);
+            }
+
+            munmap(Data, Size);
+        }
+
+        if (FileDescriptor >= 0)
+        {
+            close(FileDescriptor);
+            FileDescriptor = -1;
+        }
+#endif
+
+        Data = nullptr;
+        Size = 0;
+    }
+
+    FORCEINLINE uint8* GetData() const
+    {
+        return Data;
+    }
+
+    FORCEINLINE int64 GetSize() const
+    {
+        return Size;
+    }
+
+private:
+
+    uint8* Data = nullptr;
+    int64 Size = 0;
+    bool bWritable = false;
+
+#if GWT_MAPPED_FILE_WINDOWS
+    HANDLE FileHandle = nullptr;
+    HANDLE MappingHandle = nullptr;
+#elif GWT_MAPPED_FILE_POSIX
+    int32 FileDescriptor = -1;
+#endif
+};
+
+namespace GWTTelemetry
+{
+    int64 GetUnixTimeMs()
+    {
+        return static_cast<int64>((FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds());
+    }
+
+    bool IsValidHeader(const FGWTTelemetryHeader& Header, int64 FileSize)
+    {
+        return Header.Magic == FGWTTelemetryHeader::FileMagic
+            && Header.Version == FGWTTelemetryHeader::FileVersion
+            && Header.RecordSize == sizeof(FGWTTelemetryRecord)
+            && Header.RecordCapacity > 0
+            && FileSize >= static_cast<int64>(sizeof(FGWTTelemetryHeader) + static_cast<uint64>(Header.RecordCapacity) * sizeof(FGWTTelemetryRecord));
+    }
+}
+
+// Writer
+
+FGWTTelemetryWriter::FGWTTelemetryWriter()
+    : Header(nullptr)
+    , Records(nullptr)
+{
+}
+
+FGWTTelemetryWriter::~FGWTTelemetryWriter()
+{
+    Close();
+}
+
+bool FGWTTelemetryWriter::Open(const FString& FilePath, uint32 RecordCapacity)
+{
+    Close();
+
+    if (RecordCapacity == 0)
+    {
+        return false;
+    }
+
+    const int64 FileSize = sizeof(FGWTTelemetryHeader) + static_cast<int64>(RecordCapacity) * sizeof(FGWTTelemetryRecord);
+
+    MappedFile = MakeUnique<FGWTMappedFile>();
+
+    if (! MappedFile->Open(FilePath, FileSize, true))
+    {
+        UE_LOG(LogGWT, Warning, TEXT("FGWTTelemetryWriter::Open() - Unable to map telemetry file %s"), *FilePath);
+        MappedFile.Reset();
+        return false;
+    }
+
+    Header = reinterpret_cast<FGWTTelemetryHeader*>(MappedFile->GetData());
+    Records = reinterpret_cast<FGWTTelemetryRecord*>(MappedFile->GetData() + sizeof(FGWTTelemetryHeader));
+
+    // Append to existing file of the same format and capacity,
+    // otherwise initialize a new ring
+    if (! GWTTelemetry::IsValidHeader(*Header, FileSize) || Header->RecordCapacity != RecordCapacity)
+    {
+        FMemory::Memzero(MappedFile->GetData(), FileSize);
+
+        Header->Magic = FGWTTelemetryHeader::FileMagic;
+        Header->Version = FGWTTelemetryHeader::FileVersion;
+        Header->RecordSize = sizeof(FGWTTelemetryRecord);
+        Header->RecordCapacity = RecordCapacity;
+        Header->WriteCount = 0;
+        Header->CreateTime = GWTTelemetry::GetUnixTimeMs();
+    }
+
+    return true;
+}
+
+void FGWTTelemetryWriter::Close()
+{
+    Header = nullptr;
+    Records = nullptr;
+    MappedFile.Reset();
+}
+
+void FGWTTelemetryWriter::Write(const FGWTTelemetryRecord& Record)
+{
+    if (! IsOpen())
+    {
+        return;
+    }
+
+    const uint64 Sequence = Header->WriteCount + 1;
+    FGWTTelemetryRecord& Slot(Records[(Sequence-1) % Header->RecordCapacity]);
+
+    // Invalidate slot while it is being written
+    Slot.Sequence = 0;
+    FPlatformMisc::MemoryBarrier();
+
+    FMemory::Memcpy(
+        reinterpret_cast<uint8*>(&Slot) + sizeof(uint64),
+        reinterpret_cast<const uint8*>(&Record) + sizeof(uint64),
+        sizeof(FGWTTelemetryRecord) - sizeof(uint64)
+        );
+
+    FPlatformMisc::MemoryBarrier();
+    Slot.Sequence = Sequence;
+
+    FPlatformMisc::MemoryBarrier();
+    Header->WriteCount = Sequence;
+}
+
+// Reader
+
+FGWTTelemetryReader::FGWTTelemetryReader()
+    : Header(nullptr)
+    , Records(nullptr)
+{
+}
+
+FGWTTelemetryReader::~FGWTTelemetryReader()
+{
+    Close();
+}
+
+bool FGWTTelemetryReader::Open(const FString& FilePath)
+{
+    Close();
+
+    MappedFile = MakeUnique<FGWTMappedFile>();
+
+    if (! MappedFile->Open(FilePath, 0, false)
+        || MappedFile->GetSize() < static_cast<int64>(sizeof(FGWTTelemetryHeader)))
+    {
+        UE_LOG(LogGWT, Warning, TEXT("FGWTTelemetryReader::Open() - Unable to map telemetry file %s"), *FilePath);
+        MappedFile.Reset();
+        return false;
+    }
+
+    const FGWTTelemetryHeader* FileHeader = reinterpret_cast<const FGWTTelemetryHeader*>(MappedFile->GetData());
+
+    if (! GWTTelemetry::IsValidHeader(*FileHeader, MappedFile->GetSize()))
+    {
+        UE_LOG(LogGWT, Warning, TEXT("FGWTTelemetryReader::Open() - Invalid telemetry file %s"), *FilePath);
+        MappedFile.Reset();
+        return false;
+    }
+
+    Header = FileHeader;
+    Records = reinterpret_cast<const FGWTTelemetryRecord*>(MappedFile->GetData() + sizeof(FGWTTelemetryHeader));
+
+    return true;
+}
+
+void FGWTTelemetryReader::Close()
+{
+    Header = nullptr;
+    Records = nullptr;
+    MappedFile.Reset();
+}
+
+uint64 FGWTTelemetryReader::GetWriteCount() const
+{
+    return IsOpen() ? Header->WriteCount : 0;
+}
+
+uint64 FGWTTelemetryReader::ReadRecords(TArray<FGWTTelemetryRecord>& OutRecords, uint64 AfterSequence) const
+{
+    if (! IsOpen())
+    {
+        return AfterSequence;
+    }
+
+    const uint64 WriteCount = Header->WriteCount;
+    const uint64 RecordCapacity = Header->RecordCapacity;
+
+    FPlatformMisc::MemoryBarrier();
+
+    // Oldest sequence still present in the ring
+    const uint64 OldestSequence = (WriteCount > RecordCapacity) ? (WriteCount - RecordCapacity + 1) : 1;
+    const uint64 FirstSequence = FMath::Max(AfterSequence + 1, OldestSequence);
+
+    uint64 LastSequence = AfterSequence;
+
+    for (uint64 Sequence=FirstSequence; Sequence<=WriteCount; ++Sequence)
+    {
+        const FGWTTelemetryRecord& Slot(Records[(Sequence-1) % RecordCapacity]);
+
+        FGWTTelemetryRecord Record;
+        FMemory::Memcpy(&Record, &Slot, sizeof(FGWTTelemetryRecord));
+
+        FPlatformMisc::MemoryBarrier();
+
+        // Skip records overwritten or being written during the copy
+        if (Record.Sequence != Sequence || Slot.Sequence != Sequence)
+        {
+            continue;
+        }
+
+        OutRecords.Emplace(Record);
+        LastSequence = Sequence;
+    }
+
+    return LastSequence;
+}
+
+// Telemetry Worker
+
+FGWTTelemetryWorker::FGWTTelemetryWorker(float InSampleInterval, bool bInLowerThreadPriority)
+    : HostThread(nullptr)
+    , SampleInterval(FMath::Max(InSampleInterval, KINDA_SMALL_NUMBER))
+    , SampleTimeAccumulator(0.f)
+    , bLowerThreadPriority(bInLowerThreadPriority)
+    , LoweredThread(nullptr)
+    , PrevThreadPriority(TPri_Normal)
+{
+}
+
+FPSGWTTelemetryWorker FGWTTelemetryWorker::Create(const FString& FilePath, float SampleInterval, uint32 RecordCapacity, bool bLowerThreadPriority)
+{
+    FPSGWTTelemetryWorker Worker(MakeShareable(new FGWTTelemetryWorker(SampleInterval, bLowerThreadPriority)));
+
+    if (! Worker->GetWriter().Open(FilePath, RecordCapacity))
+    {
+        return nullptr;
+    }
+
+    return Worker;
+}
+
+void FGWTTelemetryWorker::AddThreadPool(FName SourceName, const FPSGWTAsyncThreadPool& ThreadPool)
+{
+    if (! ThreadPool.IsValid())
+    {
+        return;
+    }
+
+    FPoolSource Source;
+    Source.SourceName = SourceName;
+    Source.ThreadPool = ThreadPool;
+    ThreadPool->GetLatencyHistogram().GetSnapshot(Source.LastSnapshot);
+    Source.LastCompletedCount = ThreadPool->GetCompletedWorkCount();
+
+    FScopeLock ScopeLock(&SourceLock);
+    PoolSources.Emplace(Source);
+}
+
+void FGWTTelemetryWorker::AddThread(FName SourceName, const FPSGWTAsyncThread& Thread)
+{
+    if (! Thread.IsValid())
+    {
+        return;
+    }
+
+    FThreadSource Source;
+    Source.SourceName = SourceName;
+    Source.Thread = Thread;
+
+    FScopeLock ScopeLock(&SourceLock);
+    ThreadSources.Emplace(Source);
+}
+
+void FGWTTelemetryWorker::RemoveSource(FName SourceName)
+{
+    FScopeLock ScopeLock(&SourceLock);
+
+    PoolSources.RemoveAll([SourceName](const FPoolSource& Source) { return Source.SourceName == SourceName; });
+    ThreadSources.RemoveAll([SourceName](const FThreadSource& Source) { return Source.SourceName == SourceName; });
+}
+
+void FGWTTelemetryWorker::SetupTaskWorker()
+{
+    // Low priority thread must not receive migrated workers
+    HostThread = GetOwningThread();
+
+    if (HostThread)
+    {
+        HostThread->SetExcludeFromBalancing(true);
+    }
+
+    if (bLowerThreadPriority)
+    {
+        FRunnableThread* RunnableThread = FRunnableThread::GetRunnableThread();
+
+        if (RunnableThread)
+        {
+            LoweredThread = RunnableThread;
+            PrevThreadPriority = RunnableThread->GetThreadPriority();
+            RunnableThread->SetThreadPriority(TPri_Lowest);
+        }
+    }
+
+    SampleTimeAccumulator = 0.f;
+}
+
+void FGWTTelemetryWorker::ShutdownTaskWorker()
+{
+    // Final partial interval sample
+    WriteSamples();
+
+    // Restore priority of the hosting thread, worker removed after the thread
+    // has stopped is shut down on another thread and leaves it unchanged
+    if (LoweredThread)
+    {
+        if (FRunnableThread::GetRunnableThread() == LoweredThread)
+        {
+            LoweredThread->SetThreadPriority(PrevThreadPriority);
+        }
+
+        LoweredThread = nullptr;
+    }
+
+    if (HostThread)
+    {
+        HostThread->SetExcludeFromBalancing(false);
+        HostThread = nullptr;
+    }
+}
+
+void FGWTTelemetryWorker::Tick(float DeltaTime)
+{
+    SampleTimeAccumulator += DeltaTime;
+
+    if (SampleTimeAccumulator < SampleInterval)
+    {
+        return;
+    }
+
+    SampleTimeAccumulator = FMath::Fmod(SampleTimeAccumulator, SampleInterval);
+
+    WriteSamples();
+}
+
+void FGWTTelemetryWorker::WriteSamples()
+{
+    if (! Writer.IsOpen())
+    {
+        return;
+    }
+
+    GWT_TRACE_SCOPE("GWT.Telemetry.Sample");
+
+    const int64 Timestamp = GWTTelemetry::GetUnixTimeMs();
+
+    auto InitRecord = [Timestamp](FGWTTelemetryRecord& Record, EGWTTelemetrySource SourceType, FName SourceName)
+    {
+        FMemory::Memzero(Record);
+        Record.Timestamp = Timestamp;
+        Record.SourceType = static_cast<uint8>(SourceType);
+
+        const FString NameString(SourceName.ToString());
+        FCStringAnsi::Strncpy(Record.SourceName, TCHAR_TO_ANSI(*NameString), sizeof(Record.SourceName));
+    };
+
+    FScopeLock ScopeLock(&SourceLock);
+
+    for (FPoolSource& Source : PoolSources)
+    {
+        FPSGWTAsyncThreadPool ThreadPool(Source.ThreadPool.Pin());
+
+        if (! ThreadPool.IsValid())
+        {
+            continue;
+        }
+
+        FGWTLatencyHistogram::FSnapshot Snapshot;
+        ThreadPool->GetLatencyHistogram().GetSnapshot(Snapshot);
+
+        const FGWTLatencyHistogram::FSnapshot Delta(Snapshot.GetDelta(Source.LastSnapshot));
+        const int64 CompletedCount = ThreadPool->GetCompletedWorkCount();
+
+        FGWTTelemetryRecord Record;
+        InitRecord(Record, EGWTTelemetrySource::ThreadPool, Source.SourceName);
+        Record.QueueDepth = ThreadPool->GetQueueDepth();
+        Record.CompletedCount = static_cast<uint32>(FMath::Clamp<int64>(CompletedCount - Source.LastCompletedCount, 0, MAX_uint32));
+        Record.P50LatencyUsec = Delta.GetPercentile(.5);
+        Record.P99LatencyUsec = Delta.GetPercentile(.99);
+        Record.TickCostUsec = static_cast<uint32>(ThreadPool->GetAverageWorkTime() * 1e6);
+        Record.WorkerCount = ThreadPool->GetThreadInstanceCount();
+
+        Writer.Write(Record);
+
+        Source.LastSnapshot = Snapshot;
+        Source.LastCompletedCount = CompletedCount;
+    }
+
+    for (FThreadSource& Source : ThreadSources)
+    {
+        FPSGWTAsyncThread Thread(Source.Thread.Pin());
+
+        if (! Thread.IsValid())
+        {
+            continue;
+        }
+
+        FGWTTelemetryRecord Record;
+        InitRecord(Record, EGWTTelemetrySource::Thread, Source.SourceName);
+        Record.TickCostUsec = static_cast<uint32>(Thread->GetAverageLoopTime() * 1e6);
+        Record.WorkerCount = Thread->GetWorkerCount();
+
+        Writer.Write(Record);
+    }
+}
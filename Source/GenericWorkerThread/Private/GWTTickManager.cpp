@@ -28,8 +28,13 @@
 #include "GWTTickManager.h"
 #include "GWTAsyncTypes.h"
 #include "GWTTickUtilities.h"
+#include "GWTTrace.h"
 
 FGWTTickManager::FGWTTickManager()
+    : QueueCapacity(0)
+    , OverflowPolicy(EGWTQueueOverflowPolicy::Block)
+    , QueueDepth(0)
+    , PeakQueueDepth(0)
 {
     // Register tick delegate
     TickDelegate = FTickerDelegate::CreateRaw(this, &FGWTTickManager::Tick);
@@ -47,39 +52,208 @@ FGWTTickManager::~FGWTTickManager()
 
 bool FGWTTickManager::Tick(float DeltaTime)
 {
+    // Tick events broadcast last, after every callback queued for this tick
     ExecuteCallbacks();
+    ExecuteDeferredCallbacks();
+    ExecuteTickEvents();
 
     return true;
 }
 
 void FGWTTickManager::ExecuteCallbacks()
 {
+    DropOverflowCallbacks();
+
     while (! CallbackQueue.IsEmpty())
     {
         FTickCallback Callback;
         CallbackQueue.Dequeue(Callback);
+        FPlatformAtomics::InterlockedDecrement(&QueueDepth);
 
         if (Callback)
         {
+            GWT_TRACE_SCOPE("GWT.TickManager.Callback");
             Callback();
         }
     }
 }
 
-void FGWTTickManager::EnqueueTickCallback(const FTickCallback& TickCallback)
+void FGWTTickManager::DropOverflowCallbacks()
 {
-    CallbackQueue.Enqueue(TickCallback);
+    if (QueueCapacity <= 0 || OverflowPolicy != EGWTQueueOverflowPolicy::DropOldest)
+    {
+        return;
+    }
+
+    // Consumer side discard of the oldest callbacks exceeding capacity
+
+    int32 DropCount = GetQueueDepth() - QueueCapacity;
+
+    for (; DropCount > 0 && ! CallbackQueue.IsEmpty(); --DropCount)
+    {
+        CallbackQueue.Pop();
+        FPlatformAtomics::InterlockedDecrement(&QueueDepth);
+        DroppedCount.Increment();
+    }
+}
+
+void FGWTTickManager::WaitForQueueCapacity()
+{
+    while (QueueCapacity > 0 && GetQueueDepth() >= QueueCapacity)
+    {
+        if (IsInGameThread())
+        {
+            ExecuteCallbacks();
+        }
+        else
+        {
+            FPlatformProcess::SleepNoStats(0.f);
+        }
+    }
 }
 
-void FGWTTickManager::EnqueueTickEvent(UGWTTickEvent* TickEvent)
+bool FGWTTickManager::EnqueueTickCallback(const FTickCallback& TickCallback)
 {
-    FTickCallback TickCallback(
-        [TickEvent]()
+    int32 Depth;
+
+    // Reserve a queue slot before enqueue so that
+    // concurrent producers cannot overshoot the queue capacity
+
+    for (;;)
+    {
+        Depth = GetQueueDepth();
+
+        if (QueueCapacity > 0 && Depth >= QueueCapacity)
         {
-            if (IsValid(TickEvent))
+            switch (OverflowPolicy)
             {
-                TickEvent->BroadcastEvent();
+                case EGWTQueueOverflowPolicy::Reject:
+                    RejectedCount.Increment();
+                    return false;
+
+                case EGWTQueueOverflowPolicy::RunInline:
+                    if (IsInGameThread())
+                    {
+                        InlineCount.Increment();
+
+                        if (TickCallback)
+                        {
+                            TickCallback();
+                        }
+
+                        return true;
+                    }
+                    WaitForQueueCapacity();
+                    continue;
+
+                case EGWTQueueOverflowPolicy::Block:
+                    WaitForQueueCapacity();
+                    continue;
+
+                default:
+                    break;
             }
-        } );
-    EnqueueTickCallback(TickCallback);
+        }
+
+        if (FPlatformAtomics::InterlockedCompareExchange(&QueueDepth, Depth+1, Depth) == Depth)
+        {
+            break;
+        }
+    }
+
+    ++Depth;
+
+    int32 PeakDepth = FPlatformAtomics::AtomicRead(&PeakQueueDepth);
+
+    while (Depth > PeakDepth)
+    {
+        const int32 PrevPeakDepth = FPlatformAtomics::InterlockedCompareExchange(&PeakQueueDepth, Depth, PeakDepth);
+
+        if (PrevPeakDepth == PeakDepth)
+        {
+            break;
+        }
+
+        PeakDepth = PrevPeakDepth;
+    }
+
+    CallbackQueue.Enqueue(TickCallback);
+
+    return true;
+}
+
+void FGWTTickManager::ExecuteDeferredCallbacks()
+{
+    if (DeferredCallbackQueue.IsEmpty())
+    {
+        return;
+    }
+
+    // Gather deferred callbacks before execution so that
+    // callbacks deferred during execution run on the next tick
+
+    TArray<FTickCallback, TInlineAllocator<16>> Callbacks;
+    FTickCallback Callback;
+
+    while (DeferredCallbackQueue.Dequeue(Callback))
+    {
+        Callbacks.Emplace(MoveTemp(Callback));
+    }
+
+    for (FTickCallback& DeferredCallback : Callbacks)
+    {
+        if (DeferredCallback)
+        {
+            GWT_TRACE_SCOPE("GWT.TickManager.Callback");
+            DeferredCallback();
+        }
+    }
+}
+
+bool FGWTTickManager::EnqueueTickEvent(UGWTTickEvent* TickEvent)
+{
+    if (! IsValid(TickEvent))
+    {
+        return false;
+    }
+
+    // Event already queued for this tick
+    if (! TickEvent->MarkDirty())
+    {
+        return true;
+    }
+
+    TickEventQueue.Enqueue(TickEvent);
+
+    return true;
+}
+
+void FGWTTickManager::ExecuteTickEvents()
+{
+    if (TickEventQueue.IsEmpty())
+    {
+        return;
+    }
+
+    GWT_TRACE_SCOPE("GWT.TickManager.TickEvents");
+
+    // Gather queued events before broadcast so that events
+    // marked dirty by listeners are broadcasted on the next tick
+
+    TArray<TWeakObjectPtr<UGWTTickEvent>, TInlineAllocator<32>> TickEvents;
+    TWeakObjectPtr<UGWTTickEvent> TickEvent;
+
+    while (TickEventQueue.Dequeue(TickEvent))
+    {
+        TickEvents.Emplace(TickEvent);
+    }
+
+    for (const TWeakObjectPtr<UGWTTickEvent>& TickEventPtr : TickEvents)
+    {
+        if (UGWTTickEvent* Event = TickEventPtr.Get())
+        {
+            Event->ClearDirty();
+            Event->BroadcastEvent();
+        }
+    }
 }
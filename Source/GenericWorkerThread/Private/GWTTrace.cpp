@@ -0,0 +1,298 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "GWTTrace.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/ThreadManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/Archive.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "GenericWorkerThread.h"
+
+#if (ENGINE_MAJOR_VERSION > 4) || (ENGINE_MINOR_VERSION >= 25)
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#define GWT_TRACE_INSIGHTS CPUPROFILERTRACE_ENABLED
+#else
+#define GWT_TRACE_INSIGHTS 0
+#endif
+
+namespace GWTTrace
+{
+    struct FEvent
+    {
+        uint64 Cycles;
+        const TCHAR* Name;
+        EGWTTraceEventType Type;
+    };
+
+    // Incremented on each reset, buffers recorded in an earlier
+    // reset epoch are cleared on their next write
+    volatile int32 ResetEpoch = 0;
+
+    // Single producer ring buffer, written only by its owning thread
+    struct FThreadBuffer
+    {
+        static const int32 Capacity = 64 * 1024;
+        static const int32 Mask = Capacity - 1;
+
+        TArray<FEvent> Events;
+        volatile int32 WriteIndex = 0;
+        volatile int32 Epoch;
+        uint32 ThreadId;
+
+        FThreadBuffer(uint32 InThreadId)
+            : Epoch(FPlatformAtomics::AtomicRead(&ResetEpoch))
+            , ThreadId(InThreadId)
+        {
+            Events.SetNumUninitialized(Capacity);
+        }
+
+        FORCEINLINE void Write(const TCHAR* Name, EGWTTraceEventType Type)
+        {
+            // Write index is cleared before the epoch is published,
+            // readers of the current epoch never see the stale index
+            const int32 CurrentEpoch = FPlatformAtomics::AtomicRead(&ResetEpoch);
+
+            if (Epoch != CurrentEpoch)
+            {
+                FPlatformAtomics::InterlockedExchange(&WriteIndex, 0);
+                FPlatformAtomics::InterlockedExchange(&Epoch, CurrentEpoch);
+            }
+
+            const int32 Index = WriteIndex;
+            FEvent& Event(Events[Index & Mask]);
+            Event.Cycles = FPlatformTime::Cycles64();
+            Event.Name = Name;
+            Event.Type = Type;
+            FPlatformAtomics::InterlockedExchange(&WriteIndex, Index+1);
+        }
+    };
+
+    // Thread buffers are never released, they remain available
+    // for export after their owning thread has exited
+    FCriticalSection BufferListLock;
+    TArray<FThreadBuffer*> BufferList;
+
+    thread_local FThreadBuffer* ThreadBuffer = nullptr;
+
+    FThreadBuffer& GetThreadBuffer()
+    {
+        if (! ThreadBuffer)
+        {
+            ThreadBuffer = new FThreadBuffer(FPlatformTLS::GetCurrentThreadId());
+
+            FScopeLock ScopeLock(&BufferListLock);
+            BufferList.Emplace(ThreadBuffer);
+        }
+
+        return *ThreadBuffer;
+    }
+
+    FString EscapeJson(const FString& InString)
+    {
+        return InString.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\""));
+    }
+}
+
+volatile int32 FGWTTrace::OutputFlags = 0;
+
+void FGWTTrace::Start(EGWTTraceOutput Output)
+{
+    FPlatformAtomics::InterlockedExchange(&OutputFlags, static_cast<int32>(Output));
+}
+
+void FGWTTrace::Stop()
+{
+    FPlatformAtomics::InterlockedExchange(&OutputFlags, 0);
+}
+
+void FGWTTrace::Reset()
+{
+    // Write index is owned by the recording thread, only advance the epoch
+    FPlatformAtomics::InterlockedIncrement(&GWTTrace::ResetEpoch);
+}
+
+void FGWTTrace::Record(const TCHAR* Name, EGWTTraceEventType Type)
+{
+    Record(Name, Type, GetOutput());
+}
+
+void FGWTTrace::Record(const TCHAR* Name, EGWTTraceEventType Type, EGWTTraceOutput Output)
+{
+    if (EnumHasAnyFlags(Output, EGWTTraceOutput::Buffer))
+    {
+        GWTTrace::GetThreadBuffer().Write(Name, Type);
+    }
+
+#if GWT_TRACE_INSIGHTS
+    if (EnumHasAnyFlags(Output, EGWTTraceOutput::Insights))
+    {
+        if (Type != EGWTTraceEventType::End)
+        {
+            FCpuProfilerTrace::OutputBeginDynamicEvent(Name);
+        }
+
+        if (Type != EGWTTraceEventType::Begin)
+        {
+            FCpuProfilerTrace::OutputEndEvent();
+        }
+    }
+#endif
+}
+
+bool FGWTTrace::ExportChromeTrace(const FString& FilePath)
+{
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+
+    if (! Writer)
+    {
+        UE_LOG(LogGWT, Warning, TEXT("FGWTTrace::ExportChromeTrace() - Unable to create trace file %s"), *FilePath);
+        return false;
+    }
+
+    auto WriteString = [&Writer](const FString& String)
+    {
+        FTCHARToUTF8 Converter(*String);
+        Writer->Serialize(const_cast<ANSICHAR*>(Converter.Get()), Converter.Length());
+    };
+
+    const double MicrosecondsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1e6;
+    const uint32 ProcessId = FPlatformProcess::GetCurrentProcessId();
+
+    bool bFirstEvent = true;
+
+    auto WriteEvent = [&](const FString& EventString)
+    {
+        WriteString(bFirstEvent ? TEXT("\n") : TEXT(",\n"));
+        WriteString(EventString);
+        bFirstEvent = false;
+    };
+
+    WriteString(TEXT("{\"traceEvents\":["));
+
+    FScopeLock ScopeLock(&GWTTrace::BufferListLock);
+
+    const int32 CurrentEpoch = FPlatformAtomics::AtomicRead(&GWTTrace::ResetEpoch);
+
+    for (const GWTTrace::FThreadBuffer* Buffer : GWTTrace::BufferList)
+    {
+        // Buffer has not recorded since the last reset
+        if (FPlatformAtomics::AtomicRead(&Buffer->Epoch) != CurrentEpoch)
+        {
+            continue;
+        }
+
+        const int32 WriteIndex = FPlatformAtomics::AtomicRead(&Buffer->WriteIndex);
+        const int32 FirstIndex = FMath::Max(0, WriteIndex - GWTTrace::FThreadBuffer::Capacity);
+
+        const FString& ThreadName(FThreadManager::Get().GetThreadName(Buffer->ThreadId));
+
+        WriteEvent(FString::Printf(
+            TEXT("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"%s\"}}"),
+            ProcessId,
+            Buffer->ThreadId,
+            ThreadName.IsEmpty() ? *FString::Printf(TEXT("Thread %u"), Buffer->ThreadId) : *GWTTrace::EscapeJson(ThreadName)
+            ) );
+
+        for (int32 i=FirstIndex; i<WriteIndex; ++i)
+        {
+            const GWTTrace::FEvent& Event(Buffer->Events[i & GWTTrace::FThreadBuffer::Mask]);
+
+            const TCHAR* Phase = TEXT("i");
+
+            switch (Event.Type)
+            {
+                case EGWTTraceEventType::Begin: Phase = TEXT("B"); break;
+                case EGWTTraceEventType::End:   Phase = TEXT("E"); break;
+                default: break;
+            }
+
+            WriteEvent(FString::Printf(
+                TEXT("{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":%u,\"tid\":%u%s}"),
+                *GWTTrace::EscapeJson(Event.Name),
+                Phase,
+                Event.Cycles * MicrosecondsPerCycle,
+                ProcessId,
+                Buffer->ThreadId,
+                (Event.Type == EGWTTraceEventType::Instant) ? TEXT(",\"s\":\"t\"") : TEXT("")
+                ) );
+        }
+    }
+
+    WriteString(TEXT("\n]}\n"));
+
+    return Writer->Close();
+}
+
+// Console Commands
+
+static FAutoConsoleCommand GWTTraceStartCommand(
+    TEXT("GWT.Trace.Start"),
+    TEXT("Start recording GenericWorkerThread timeline events. Optional argument: Insights, All"),
+    FConsoleCommandWithArgsDelegate::CreateLambda(
+        [](const TArray<FString>& Args)
+        {
+            EGWTTraceOutput Output = EGWTTraceOutput::Buffer;
+
+            if (Args.Num() > 0)
+            {
+                if (Args[0] == TEXT("Insights"))
+                {
+                    Output = EGWTTraceOutput::Insights;
+                }
+                else if (Args[0] == TEXT("All"))
+                {
+                    Output = EGWTTraceOutput::All;
+                }
+            }
+
+            FGWTTrace::Start(Output);
+        } ) );
+
+static FAutoConsoleCommand GWTTraceStopCommand(
+    TEXT("GWT.Trace.Stop"),
+    TEXT("Stop recording GenericWorkerThread timeline events"),
+    FConsoleCommandDelegate::CreateStatic(&FGWTTrace::Stop) );
+
+static FAutoConsoleCommand GWTTraceExportCommand(
+    TEXT("GWT.Trace.Export"),
+    TEXT("Export recorded GenericWorkerThread timeline events as Chrome trace JSON. Optional argument: file path"),
+    FConsoleCommandWithArgsDelegate::CreateLambda(
+        [](const TArray<FString>& Args)
+        {
+            const FString FilePath = (Args.Num() > 0)
+                ? Args[0]
+                : FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("GWTTrace.json");
+
+            if (FGWTTrace::ExportChromeTrace(FilePath))
+            {
+                UE_LOG(LogGWT, Log, TEXT("GWT.Trace.Export - Trace exported to %s"), *FilePath);
+            }
+        } ) );
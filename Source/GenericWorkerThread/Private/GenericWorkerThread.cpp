@@ -29,13 +29,17 @@
 #include "GWTAsyncThreadManager.h"
 #include "GWTTaskWorker.h"
 #include "GWTTickManager.h"
+#include "GWTObjectPool.h"
 
 #define LOCTEXT_NAMESPACE "FGenericWorkerThread"
 
+DEFINE_LOG_CATEGORY(LogGWT);
+
 class FGenericWorkerThread : public IGenericWorkerThread
 {
     FGWTAsyncThreadManager AsyncThreadManager;
     FGWTTickManager        TickManager;
+    FGWTObjectPool         ObjectPool;
 
 public:
 
@@ -70,6 +74,16 @@ public:
     {
         return TickManager;
     }
+
+    virtual FGWTObjectPool& GetObjectPool()
+    {
+        return ObjectPool;
+    }
+
+    virtual const FGWTObjectPool& GetObjectPool() const
+    {
+        return ObjectPool;
+    }
 };
 
 #undef LOCTEXT_NAMESPACE
@@ -31,8 +31,11 @@
 #include "Stats/Stats.h"
 #include "Modules/ModuleInterface.h"
 
+GENERICWORKERTHREAD_API DECLARE_LOG_CATEGORY_EXTERN(LogGWT, Log, All);
+
 class FGWTAsyncThreadManager;
 class FGWTTickManager;
+class FGWTObjectPool;
 
 class IGenericWorkerThread : public IModuleInterface
 {
@@ -53,4 +56,7 @@ public:
 
     virtual FGWTTickManager& GetTickManager() = 0;
     virtual const FGWTTickManager& GetTickManager() const = 0;
+
+    virtual FGWTObjectPool& GetObjectPool() = 0;
+    virtual const FGWTObjectPool& GetObjectPool() const = 0;
 };